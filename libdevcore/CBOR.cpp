@@ -0,0 +1,327 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file CBOR.cpp
+ * Conversion between JSON values and their CBOR (RFC 7049) encoding.
+ */
+
+#include <libdevcore/CBOR.h>
+
+#include <cstring>
+#include <limits>
+
+using namespace std;
+
+namespace dev
+{
+
+namespace
+{
+
+enum MajorType: uint8_t
+{
+	UnsignedInteger = 0,
+	NegativeInteger = 1,
+	TextString = 3,
+	Array = 4,
+	Map = 5,
+	Simple = 7
+};
+
+uint8_t const c_false = 0xf4;
+uint8_t const c_true = 0xf5;
+uint8_t const c_null = 0xf6;
+uint8_t const c_float = 0xfa;
+uint8_t const c_double = 0xfb;
+
+/// Appends the initial byte of a data item of type @a _type with argument
+/// @a _argument, followed by the argument in its shortest form.
+void encodeHead(bytes& _output, MajorType _type, uint64_t _argument)
+{
+	uint8_t const type = uint8_t(_type << 5);
+	if (_argument < 24)
+	{
+		_output.push_back(type | uint8_t(_argument));
+		return;
+	}
+	unsigned length;
+	if (_argument <= 0xff)
+	{
+		_output.push_back(type | 24);
+		length = 1;
+	}
+	else if (_argument <= 0xffff)
+	{
+		_output.push_back(type | 25);
+		length = 2;
+	}
+	else if (_argument <= 0xffffffff)
+	{
+		_output.push_back(type | 26);
+		length = 4;
+	}
+	else
+	{
+		_output.push_back(type | 27);
+		length = 8;
+	}
+	for (unsigned i = length; i > 0; --i)
+		_output.push_back(uint8_t(_argument >> (8 * (i - 1))));
+}
+
+void encodeString(bytes& _output, char const* _begin, char const* _end)
+{
+	encodeHead(_output, TextString, uint64_t(_end - _begin));
+	_output.insert(_output.end(), _begin, _end);
+}
+
+void encode(bytes& _output, Json::Value const& _value)
+{
+	switch (_value.type())
+	{
+	case Json::nullValue:
+		_output.push_back(c_null);
+		break;
+	case Json::intValue:
+	{
+		Json::Int64 value = _value.asInt64();
+		if (value >= 0)
+			encodeHead(_output, UnsignedInteger, uint64_t(value));
+		else
+			// -1 - value does not overflow for the smallest value.
+			encodeHead(_output, NegativeInteger, uint64_t(-(value + 1)));
+		break;
+	}
+	case Json::uintValue:
+		encodeHead(_output, UnsignedInteger, _value.asUInt64());
+		break;
+	case Json::realValue:
+	{
+		double value = _value.asDouble();
+		uint64_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		_output.push_back(c_double);
+		for (unsigned i = 8; i > 0; --i)
+			_output.push_back(uint8_t(bits >> (8 * (i - 1))));
+		break;
+	}
+	case Json::stringValue:
+	{
+		char const* begin = nullptr;
+		char const* end = nullptr;
+		_value.getString(&begin, &end);
+		encodeString(_output, begin, end);
+		break;
+	}
+	case Json::booleanValue:
+		_output.push_back(_value.asBool() ? c_true : c_false);
+		break;
+	case Json::arrayValue:
+		encodeHead(_output, Array, _value.size());
+		for (auto const& element: _value)
+			encode(_output, element);
+		break;
+	case Json::objectValue:
+		// The members are iterated in ascending order of their names.
+		encodeHead(_output, Map, _value.size());
+		for (auto it = _value.begin(); it != _value.end(); ++it)
+		{
+			char const* end = nullptr;
+			char const* begin = it.memberName(&end);
+			encodeString(_output, begin, end);
+			encode(_output, *it);
+		}
+		break;
+	}
+}
+
+class Decoder
+{
+public:
+	explicit Decoder(bytesConstRef _data): m_data(_data) {}
+
+	Json::Value decodeAll()
+	{
+		Json::Value value = decode(0);
+		if (m_position != m_data.size())
+			fail("Trailing data.");
+		return value;
+	}
+
+private:
+	/// Arrays and maps can be nested up to this depth, which is also the limit of the JSON parser.
+	/// Deeper data is rejected, so that crafted input cannot exhaust the stack.
+	static size_t const c_maxDepth = 1000;
+
+	/// Decodes the next data item, which is nested in @a _depth arrays and maps.
+	Json::Value decode(size_t _depth)
+	{
+		uint8_t initial = readByte();
+		MajorType type = MajorType(initial >> 5);
+		switch (type)
+		{
+		case UnsignedInteger:
+		{
+			uint64_t value = readArgument(initial);
+			if (value <= uint64_t(numeric_limits<Json::Int64>::max()))
+				return Json::Value(Json::Int64(value));
+			return Json::Value(Json::UInt64(value));
+		}
+		case NegativeInteger:
+		{
+			uint64_t value = readArgument(initial);
+			if (value > uint64_t(numeric_limits<Json::Int64>::max()))
+				fail("Negative integer out of range.");
+			return Json::Value(-1 - Json::Int64(value));
+		}
+		case TextString:
+		{
+			uint64_t length = readArgument(initial);
+			char const* begin = readBytes(length);
+			return Json::Value(begin, begin + length);
+		}
+		case Array:
+		{
+			checkDepth(_depth);
+			uint64_t size = readSize(initial);
+			Json::Value value(Json::arrayValue);
+			value.resize(Json::ArrayIndex(size));
+			for (Json::ArrayIndex i = 0; i < size; ++i)
+				value[i] = decode(_depth + 1);
+			return value;
+		}
+		case Map:
+		{
+			checkDepth(_depth);
+			uint64_t size = readSize(initial);
+			Json::Value value(Json::objectValue);
+			for (uint64_t i = 0; i < size; ++i)
+			{
+				uint8_t keyInitial = readByte();
+				if (MajorType(keyInitial >> 5) != TextString)
+					fail("Map key is not a text string.");
+				uint64_t length = readArgument(keyInitial);
+				char const* begin = readBytes(length);
+				value[string(begin, length)] = decode(_depth + 1);
+			}
+			return value;
+		}
+		case Simple:
+			switch (initial)
+			{
+			case c_false:
+				return Json::Value(false);
+			case c_true:
+				return Json::Value(true);
+			case c_null:
+				return Json::Value();
+			case c_float:
+			{
+				uint32_t bits = uint32_t(readUnsigned(4));
+				float value;
+				memcpy(&value, &bits, sizeof(value));
+				return Json::Value(double(value));
+			}
+			case c_double:
+			{
+				uint64_t bits = readUnsigned(8);
+				double value;
+				memcpy(&value, &bits, sizeof(value));
+				return Json::Value(value);
+			}
+			default:
+				fail("Unsupported simple value.");
+			}
+		default:
+			fail("Unsupported major type.");
+		}
+	}
+
+	uint8_t readByte()
+	{
+		if (m_position >= m_data.size())
+			fail("Unexpected end of data.");
+		return m_data[m_position++];
+	}
+
+	uint64_t readUnsigned(unsigned _length)
+	{
+		uint64_t value = 0;
+		for (unsigned i = 0; i < _length; ++i)
+			value = (value << 8) | readByte();
+		return value;
+	}
+
+	uint64_t readArgument(uint8_t _initial)
+	{
+		uint8_t info = _initial & 0x1f;
+		if (info < 24)
+			return info;
+		else if (info <= 27)
+			return readUnsigned(1u << (info - 24));
+		fail("Unsupported argument encoding.");
+	}
+
+	/// Reads the number of elements of an array or map. Since every element occupies
+	/// at least one byte, larger numbers are rejected before anything is allocated.
+	uint64_t readSize(uint8_t _initial)
+	{
+		uint64_t size = readArgument(_initial);
+		if (size > m_data.size() - m_position)
+			fail("Unexpected end of data.");
+		return size;
+	}
+
+	void checkDepth(size_t _depth)
+	{
+		if (_depth >= c_maxDepth)
+			fail("Nesting too deep.");
+	}
+
+	/// Skips @a _length bytes and returns a pointer to them.
+	char const* readBytes(uint64_t _length)
+	{
+		if (_length > m_data.size() - m_position)
+			fail("Unexpected end of data.");
+		char const* begin = reinterpret_cast<char const*>(m_data.data()) + m_position;
+		m_position += size_t(_length);
+		return begin;
+	}
+
+	[[noreturn]] void fail(string const& _message)
+	{
+		BOOST_THROW_EXCEPTION(CBORDecodingError() << errinfo_comment(_message));
+	}
+
+	bytesConstRef m_data;
+	size_t m_position = 0;
+};
+
+}
+
+bytes cborEncode(Json::Value const& _value)
+{
+	bytes output;
+	encode(output, _value);
+	return output;
+}
+
+Json::Value cborDecode(bytesConstRef _data)
+{
+	return Decoder(_data).decodeAll();
+}
+
+}
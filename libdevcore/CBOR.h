@@ -0,0 +1,44 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file CBOR.h
+ * Conversion between JSON values and their CBOR (RFC 7049) encoding.
+ */
+
+#pragma once
+
+#include <libdevcore/Common.h>
+#include <libdevcore/Exceptions.h>
+
+#include <json/json.h>
+
+namespace dev
+{
+
+DEV_SIMPLE_EXCEPTION(CBORDecodingError);
+
+/// Encodes @a _value as CBOR. Objects become maps whose keys are in ascending order,
+/// integers are encoded in their shortest form and reals as double precision floats,
+/// so the encoding does not depend on how the value was built.
+bytes cborEncode(Json::Value const& _value);
+
+/// Decodes a single CBOR data item that covers all of @a _data.
+/// Only the data types that cborEncode produces and single precision floats are supported,
+/// and arrays and maps can be nested at most 1000 levels deep.
+/// Throws CBORDecodingError if the data is malformed or contains unsupported items.
+Json::Value cborDecode(bytesConstRef _data);
+
+}
@@ -83,6 +83,14 @@ bool parse(Json::CharReaderBuilder& _builder, string const& _input, Json::Value&
 	return reader->parse(_input.c_str(), _input.c_str() + _input.length(), &_json, _errs);
 }
 
+/// @returns the builder for writers that produce JSON without any whitespace.
+Json::StreamWriterBuilder const& compactWriterBuilder()
+{
+	static map<string, string> settings{{"indentation", ""}};
+	static StreamWriterBuilder writerBuilder(settings);
+	return writerBuilder;
+}
+
 } // end anonymous namespace
 
 string jsonPrettyPrint(Json::Value const& _input)
@@ -94,9 +102,7 @@ string jsonPrettyPrint(Json::Value const& _input)
 
 string jsonCompactPrint(Json::Value const& _input)
 {
-	static map<string, string> settings{{"indentation", ""}};
-	static StreamWriterBuilder writerBuilder(settings);
-	return print(_input, writerBuilder);
+	return print(_input, compactWriterBuilder());
 }
 
 bool jsonParseStrict(string const& _input, Json::Value& _json, string* _errs /* = nullptr */)
@@ -111,4 +117,86 @@ bool jsonParse(string const& _input, Json::Value& _json, string *_errs /* = null
 	return parse(readerBuilder, _input, _json, _errs);
 }
 
+JsonStreamWriter::JsonStreamWriter(ostream& _stream):
+	m_stream(_stream),
+	m_writer(compactWriterBuilder().newStreamWriter())
+{
+}
+
+void JsonStreamWriter::beginObject()
+{
+	beginValue();
+	m_stream << '{';
+	m_containers.push_back({false, false, string()});
+}
+
+void JsonStreamWriter::member(string const& _name)
+{
+	if (m_containers.back().hasElements)
+		m_stream << ',';
+	m_containers.back().hasElements = true;
+	m_containers.back().lastMember = _name;
+	m_writer->write(Json::Value(_name), &m_stream);
+	m_stream << ':';
+	m_valuePending = true;
+}
+
+void JsonStreamWriter::endObject()
+{
+	m_stream << '}';
+	m_containers.pop_back();
+}
+
+void JsonStreamWriter::beginArray()
+{
+	beginValue();
+	m_stream << '[';
+	m_containers.push_back({true, false, string()});
+}
+
+void JsonStreamWriter::endArray()
+{
+	m_stream << ']';
+	m_containers.pop_back();
+}
+
+void JsonStreamWriter::value(Json::Value const& _value)
+{
+	beginValue();
+	m_writer->write(_value, &m_stream);
+}
+
+void JsonStreamWriter::endAll(size_t _keep)
+{
+	if (m_valuePending)
+		value(Json::Value());
+	while (m_containers.size() > _keep)
+		if (m_containers.back().isArray)
+			endArray();
+		else
+			endObject();
+}
+
+void JsonStreamWriter::beginValue()
+{
+	if (!m_containers.empty() && m_containers.back().isArray)
+	{
+		if (m_containers.back().hasElements)
+			m_stream << ',';
+		m_containers.back().hasElements = true;
+	}
+	m_valuePending = false;
+	m_empty = false;
+}
+
+Json::Value& JsonTreeWriter::insert(Json::Value const& _value)
+{
+	if (m_containers.empty())
+		return m_result = _value;
+	else if (m_containers.back()->isArray())
+		return m_containers.back()->append(_value);
+	else
+		return (*m_containers.back())[m_member] = _value;
+}
+
 } // namespace dev
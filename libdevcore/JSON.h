@@ -24,7 +24,10 @@
 
 #include <json/json.h>
 
+#include <memory>
+#include <ostream>
 #include <string>
+#include <vector>
 
 namespace dev {
 
@@ -48,4 +51,78 @@ bool jsonParseStrict(std::string const& _input, Json::Value& _json, std::string*
 /// \return \c true if the document was successfully parsed, \c false if an error occurred.
 bool jsonParse(std::string const& _input, Json::Value& _json, std::string* _errs = nullptr);
 
+/// Writes compact JSON to a stream piece by piece, so that large documents do not
+/// have to be built in memory. Members appear in the order they are written, so the
+/// output is identical to jsonCompactPrint of the equivalent Json::Value only if the
+/// members of each object are written in ascending order of their names, which is the
+/// order Json::Value uses.
+/// Values (including objects and arrays) are written as the top-level value, as the
+/// value of the current member or as the next element of the current array.
+class JsonStreamWriter
+{
+public:
+	explicit JsonStreamWriter(std::ostream& _stream);
+
+	void beginObject();
+	/// Starts the member @a _name of the current object. Its value has to be written next.
+	void member(std::string const& _name);
+	void endObject();
+	void beginArray();
+	void endArray();
+	void value(Json::Value const& _value);
+	/// Ends the objects and arrays that are still open until only @a _keep of them remain.
+	/// A member whose value has not been written yet is set to null.
+	void endAll(size_t _keep = 0);
+
+	/// @returns true if nothing has been written yet.
+	bool empty() const { return m_empty; }
+	/// @returns the number of objects and arrays that are open.
+	size_t depth() const { return m_containers.size(); }
+	/// @returns the name of the member most recently started in the open object at nesting
+	/// level @a _level (0 is the outermost one), or an empty string if there is none.
+	std::string const& lastMember(size_t _level) const { return m_containers.at(_level).lastMember; }
+
+private:
+	struct Container
+	{
+		bool isArray;
+		bool hasElements;
+		std::string lastMember;
+	};
+
+	/// Writes the separator needed before a value.
+	void beginValue();
+
+	std::ostream& m_stream;
+	std::unique_ptr<Json::StreamWriter> m_writer;
+	/// The objects and arrays that are open.
+	std::vector<Container> m_containers;
+	/// Whether a member name has been written, but not its value.
+	bool m_valuePending = false;
+	bool m_empty = true;
+};
+
+/// Builds a Json::Value through the interface of JsonStreamWriter, so that a single
+/// function template can produce both streamed and in-memory JSON.
+class JsonTreeWriter
+{
+public:
+	void beginObject() { m_containers.push_back(&insert(Json::objectValue)); }
+	void member(std::string const& _name) { m_member = _name; }
+	void endObject() { m_containers.pop_back(); }
+	void beginArray() { m_containers.push_back(&insert(Json::arrayValue)); }
+	void endArray() { m_containers.pop_back(); }
+	void value(Json::Value const& _value) { insert(_value); }
+
+	Json::Value const& result() const { return m_result; }
+
+private:
+	Json::Value& insert(Json::Value const& _value);
+
+	Json::Value m_result;
+	/// The open objects and arrays, pointing into m_result.
+	std::vector<Json::Value*> m_containers;
+	std::string m_member;
+};
+
 }
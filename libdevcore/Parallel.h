@@ -0,0 +1,84 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file Parallel.h
+ * Helper for running independent tasks on multiple threads.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace dev
+{
+
+/// Calls @a _task(i) for every i in [0, _count) using up to @a _jobs threads,
+/// the calling thread included. If @a _jobs is at most one, the tasks are run
+/// in order on the calling thread.
+/// If tasks throw, the exception thrown by the task with the lowest index is
+/// rethrown once all tasks are finished, independently of the scheduling.
+/// If threads cannot be created (e.g. on platforms without thread support),
+/// the remaining tasks are run on the calling thread.
+template <class Task>
+void parallelFor(size_t _count, unsigned _jobs, Task const& _task)
+{
+	if (_jobs <= 1 || _count <= 1)
+	{
+		for (size_t i = 0; i < _count; ++i)
+			_task(i);
+		return;
+	}
+
+	std::atomic<size_t> nextTask{0};
+	std::vector<std::exception_ptr> exceptions(_count);
+	auto worker = [&]()
+	{
+		for (size_t i = nextTask++; i < _count; i = nextTask++)
+			try
+			{
+				_task(i);
+			}
+			catch (...)
+			{
+				exceptions[i] = std::current_exception();
+			}
+	};
+
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < std::min<size_t>(_jobs, _count); ++i)
+		try
+		{
+			threads.emplace_back(worker);
+		}
+		catch (std::system_error const&)
+		{
+			break;
+		}
+	worker();
+	for (auto& thread: threads)
+		thread.join();
+
+	for (auto const& exception: exceptions)
+		if (exception)
+			std::rethrow_exception(exception);
+}
+
+}
@@ -20,6 +20,7 @@
  */
 
 #include "SHA3.h"
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
@@ -227,6 +228,60 @@ defkeccak(512)
 
 }
 
+namespace
+{
+/// Number of bytes absorbed per Keccak-f application for a 256 bit output.
+size_t const c_keccak256Rate = 200 - 256 / 4;
+}
+
+vector<h256> keccak256Batch(vector<bytesConstRef> const& _inputs)
+{
+	vector<h256> hashes;
+	hashes.reserve(_inputs.size());
+	for (bytesConstRef input: _inputs)
+		hashes.push_back(keccak256(input));
+	return hashes;
+}
+
+void Keccak256::reset()
+{
+	memset(m_state, 0, sizeof(m_state));
+	m_position = 0;
+}
+
+void Keccak256::update(bytesConstRef _data)
+{
+	uint8_t* state = reinterpret_cast<uint8_t*>(m_state);
+	uint8_t const* input = _data.data();
+	size_t length = _data.size();
+	while (length > 0)
+	{
+		size_t const count = min(length, c_keccak256Rate - m_position);
+		keccak::xorin(state + m_position, input, count);
+		m_position += count;
+		input += count;
+		length -= count;
+		if (m_position == c_keccak256Rate)
+		{
+			keccak::keccakf(state);
+			m_position = 0;
+		}
+	}
+}
+
+h256 Keccak256::finalize()
+{
+	// Same padding as in keccak::hash.
+	uint8_t* state = reinterpret_cast<uint8_t*>(m_state);
+	state[m_position] ^= 0x01;
+	state[c_keccak256Rate - 1] ^= 0x80;
+	keccak::keccakf(state);
+	h256 ret;
+	memcpy(ret.data(), state, 32);
+	reset();
+	return ret;
+}
+
 bool keccak256(bytesConstRef _input, bytesRef o_output)
 {
 	// FIXME: What with unaligned memory?
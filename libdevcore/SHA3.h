@@ -26,6 +26,7 @@
 #include <libdevcore/FixedHash.h>
 
 #include <string>
+#include <vector>
 
 namespace dev
 {
@@ -48,4 +49,30 @@ inline h256 keccak256(std::string const& _input) { return keccak256(bytesConstRe
 /// Calculate Keccak-256 hash of the given input (presented as a FixedHash), returns a 256-bit hash.
 template<unsigned N> inline h256 keccak256(FixedHash<N> const& _input) { return keccak256(_input.ref()); }
 
+/// Calculate the Keccak-256 hashes of all @a _inputs, returning them in the same order.
+std::vector<h256> keccak256Batch(std::vector<bytesConstRef> const& _inputs);
+
+/// Incremental Keccak-256 computation: The hash of data that is added in several
+/// pieces equals the hash of the concatenated data, but the data does not have to
+/// be concatenated in memory.
+class Keccak256
+{
+public:
+	Keccak256() { reset(); }
+
+	/// Discards all data added so far.
+	void reset();
+	/// Adds @a _data to the hashed data.
+	void update(bytesConstRef _data);
+	/// @returns the hash of all data added since construction or the last reset
+	/// and resets the state.
+	h256 finalize();
+
+private:
+	/// The Keccak-f[1600] state.
+	uint64_t m_state[25];
+	/// Number of bytes already absorbed into the current block.
+	size_t m_position;
+};
+
 }
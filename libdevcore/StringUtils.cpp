@@ -36,6 +36,9 @@ bool dev::stringWithinDistance(string const& _str1, string const& _str2, size_t
 
 	size_t n1 = _str1.size();
 	size_t n2 = _str2.size();
+	// the distance is at least the difference in length
+	if ((n1 > n2 ? n1 - n2 : n2 - n1) > _maxDistance)
+		return false;
 	size_t distance = stringDistance(_str1, _str2);
 
 	// if distance is not greater than _maxDistance, and distance is strictly less than length of both names, they can be considered similar
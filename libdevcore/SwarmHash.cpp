@@ -19,51 +19,79 @@
 
 #include <libdevcore/SwarmHash.h>
 
+#include <libdevcore/Parallel.h>
 #include <libdevcore/SHA3.h>
 
+#include <array>
+
 using namespace std;
 using namespace dev;
 
 namespace
 {
 
-bytes toLittleEndian(size_t _size)
+size_t const c_chunkSize = 0x1000;
+/// Number of child hashes stored in an inner node.
+size_t const c_branches = c_chunkSize / 32;
+/// Inputs smaller than this are not worth hashing concurrently.
+size_t const c_minParallelSize = 16 * c_chunkSize;
+
+void updateWithLittleEndian(Keccak256& _hasher, size_t _size)
 {
-	bytes encoded(8);
+	byte encoded[8];
 	for (size_t i = 0; i < 8; ++i)
 		encoded[i] = (_size >> (8 * i)) & 0xff;
-	return encoded;
-}
-
-h256 swarmHashSimple(bytesConstRef _data, size_t _size)
-{
-	return keccak256(toLittleEndian(_size) + _data.toBytes());
+	_hasher.update(bytesConstRef(encoded, 8));
 }
 
-h256 swarmHashIntermediate(string const& _input, size_t _offset, size_t _length)
+/// Computes the hash of the node representing @a _data, which is the hash of the size of
+/// @a _data followed by either @a _data itself or, if it does not fit into a chunk, the
+/// hashes of the subtrees. The subtrees are hashed directly into a single hasher state, so
+/// that the data is never copied.
+h256 swarmHashNode(bytesConstRef _data, unsigned _jobs)
 {
-	bytesConstRef ref;
-	bytes innerNodes;
-	if (_length <= 0x1000)
-		ref = bytesConstRef(_input).cropped(_offset, _length);
+	Keccak256 hasher;
+	updateWithLittleEndian(hasher, _data.size());
+	if (_data.size() <= c_chunkSize)
+		hasher.update(_data);
 	else
 	{
-		size_t maxRepresentedSize = 0x1000;
-		while (maxRepresentedSize * (0x1000 / 32) < _length)
-			maxRepresentedSize *= (0x1000 / 32);
-		for (size_t i = 0; i < _length; i += maxRepresentedSize)
+		size_t subtreeSize = c_chunkSize;
+		while (subtreeSize * c_branches < _data.size())
+			subtreeSize *= c_branches;
+		size_t const subtrees = (_data.size() + subtreeSize - 1) / subtreeSize;
+		auto subtree = [&](size_t _index)
 		{
-			size_t size = std::min(maxRepresentedSize, _length - i);
-			innerNodes += swarmHashIntermediate(_input, _offset + i, size).asBytes();
+			return _data.cropped(_index * subtreeSize, min(subtreeSize, _data.size() - _index * subtreeSize));
+		};
+		if (_jobs <= 1 || _data.size() < c_minParallelSize)
+			for (size_t i = 0; i < subtrees; ++i)
+				hasher.update(swarmHashNode(subtree(i), 1).ref());
+		else
+		{
+			// Subtrees are independent. If there are fewer subtrees than threads,
+			// the remaining threads are used further down the tree.
+			array<h256, c_branches> hashes;
+			unsigned const subtreeJobs = max(1u, unsigned(_jobs / subtrees));
+			parallelFor(subtrees, _jobs, [&](size_t _index)
+			{
+				hashes[_index] = swarmHashNode(subtree(_index), subtreeJobs);
+			});
+			for (size_t i = 0; i < subtrees; ++i)
+				hasher.update(hashes[i].ref());
 		}
-		ref = bytesConstRef(&innerNodes);
 	}
-	return swarmHashSimple(ref, _length);
+	return hasher.finalize();
 }
 
 }
 
 h256 dev::swarmHash(string const& _input)
 {
-	return swarmHashIntermediate(_input, 0, _input.size());
+	return swarmHashNode(bytesConstRef(_input), 1);
+}
+
+h256 dev::swarmHash(bytesConstRef _input, unsigned _jobs)
+{
+	return swarmHashNode(_input, _jobs);
 }
@@ -29,4 +29,8 @@ namespace dev
 /// Compute the "swarm hash" of @a _input
 h256 swarmHash(std::string const& _input);
 
+/// Compute the "swarm hash" of @a _input, hashing independent subtrees of large
+/// inputs concurrently using up to @a _jobs threads.
+h256 swarmHash(bytesConstRef _input, unsigned _jobs = 1);
+
 }
@@ -25,11 +25,196 @@
 
 #include <libdevcore/Assertions.h>
 
-#include <boost/regex.hpp>
+#include <mutex>
+#include <unordered_map>
 
 using namespace std;
 using namespace dev;
 
+namespace
+{
+
+/// Part of a parsed template: Literal text, a tag <name> or a list <#name>...</name>.
+struct Segment
+{
+	enum class Kind { Literal, Tag, List };
+	Kind kind;
+	/// Literal text or name of the tag or list.
+	string text;
+	/// Parsed body of a list.
+	vector<Segment> body;
+};
+
+/// Parses @a _template into segments. Recognizes exactly what the regular expression
+/// <([^#/>]+)>|<#([^>]+)>(.*?)</\2> would match when scanning from left to right,
+/// so that the rendered result does not change compared to regex-based replacement.
+vector<Segment> parseTemplate(string const& _template)
+{
+	vector<Segment> segments;
+	size_t literalStart = 0;
+	auto addLiteral = [&](size_t _end)
+	{
+		if (_end > literalStart)
+			segments.push_back(Segment{Segment::Kind::Literal, _template.substr(literalStart, _end - literalStart), {}});
+	};
+	size_t pos = 0;
+	while ((pos = _template.find('<', pos)) != string::npos)
+	{
+		size_t tagEnd = _template.find_first_of("#/>", pos + 1);
+		if (tagEnd != string::npos && _template[tagEnd] == '>' && tagEnd > pos + 1)
+		{
+			addLiteral(pos);
+			segments.push_back(Segment{Segment::Kind::Tag, _template.substr(pos + 1, tagEnd - pos - 1), {}});
+			literalStart = pos = tagEnd + 1;
+			continue;
+		}
+		if (pos + 1 < _template.size() && _template[pos + 1] == '#')
+		{
+			size_t nameEnd = _template.find('>', pos + 2);
+			if (nameEnd != string::npos && nameEnd > pos + 2)
+			{
+				string name = _template.substr(pos + 2, nameEnd - pos - 2);
+				string closingTag = "</" + name + ">";
+				size_t bodyEnd = _template.find(closingTag, nameEnd + 1);
+				if (bodyEnd != string::npos)
+				{
+					addLiteral(pos);
+					segments.push_back(Segment{
+						Segment::Kind::List,
+						name,
+						parseTemplate(_template.substr(nameEnd + 1, bodyEnd - nameEnd - 1))
+					});
+					literalStart = pos = bodyEnd + closingTag.size();
+					continue;
+				}
+			}
+		}
+		++pos;
+	}
+	addLiteral(_template.size());
+	return segments;
+}
+
+/// @returns the parsed form of @a _template. Templates are only parsed once, the result
+/// is cached for the lifetime of the process (the templates are string literals in the code).
+shared_ptr<vector<Segment> const> compiledTemplate(string const& _template)
+{
+	static mutex cacheMutex;
+	static unordered_map<string, shared_ptr<vector<Segment> const>> cache;
+	lock_guard<mutex> lock(cacheMutex);
+	auto& compiled = cache[_template];
+	if (!compiled)
+		compiled = make_shared<vector<Segment> const>(parseTemplate(_template));
+	return compiled;
+}
+
+/// Renders parsed templates. Inside list bodies, parameters are looked up in the
+/// parameters of the current list item and the top-level parameters.
+class Renderer
+{
+public:
+	Renderer(
+		string const& _template,
+		Whiskers::StringMap const& _parameters,
+		Whiskers::StringListMap const& _listParameters
+	):
+		m_template(_template),
+		m_parameters(_parameters),
+		m_listParameters(_listParameters)
+	{}
+
+	string render(vector<Segment> const& _segments)
+	{
+		string result;
+		result.reserve(size(_segments, nullptr));
+		append(_segments, nullptr, result);
+		return result;
+	}
+
+private:
+	/// @returns the size of the rendered @a _segments.
+	size_t size(vector<Segment> const& _segments, Whiskers::StringMap const* _item)
+	{
+		size_t result = 0;
+		for (Segment const& segment: _segments)
+			switch (segment.kind)
+			{
+			case Segment::Kind::Literal:
+				result += segment.text.size();
+				break;
+			case Segment::Kind::Tag:
+				result += value(segment.text, _item).size();
+				break;
+			case Segment::Kind::List:
+				for (auto const& item: list(segment.text, _item))
+					result += size(segment.body, &item);
+				break;
+			}
+		return result;
+	}
+
+	void append(vector<Segment> const& _segments, Whiskers::StringMap const* _item, string& _out)
+	{
+		for (Segment const& segment: _segments)
+			switch (segment.kind)
+			{
+			case Segment::Kind::Literal:
+				_out += segment.text;
+				break;
+			case Segment::Kind::Tag:
+				_out += value(segment.text, _item);
+				break;
+			case Segment::Kind::List:
+				for (auto const& item: list(segment.text, _item))
+					append(segment.body, &item, _out);
+				break;
+			}
+	}
+
+	string const& value(string const& _tagName, Whiskers::StringMap const* _item)
+	{
+		if (_item)
+		{
+			auto it = _item->find(_tagName);
+			if (it != _item->end())
+				return it->second;
+		}
+		auto it = m_parameters.find(_tagName);
+		assertThrow(
+			it != m_parameters.end(),
+			WhiskersError,
+			"Value for tag " + _tagName + " not provided.\n" +
+			"Template:\n" +
+			m_template
+		);
+		return it->second;
+	}
+
+	vector<Whiskers::StringMap> const& list(string const& _listName, Whiskers::StringMap const* _item)
+	{
+		// Lists cannot be nested.
+		auto it = m_listParameters.find(_listName);
+		assertThrow(
+			!_item && it != m_listParameters.end(),
+			WhiskersError, "List parameter " + _listName + " not set."
+		);
+		for (auto const& item: it->second)
+			for (auto const& parameter: item)
+				assertThrow(
+					!m_parameters.count(parameter.first),
+					WhiskersError,
+					"Parameter collision"
+				);
+		return it->second;
+	}
+
+	string const& m_template;
+	Whiskers::StringMap const& m_parameters;
+	Whiskers::StringListMap const& m_listParameters;
+};
+
+}
+
 Whiskers::Whiskers(string const& _template):
 m_template(_template)
 {
@@ -74,60 +259,5 @@ Whiskers& Whiskers::operator ()(
 
 string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_listParameters);
+	return Renderer(m_template, m_parameters, m_listParameters).render(*compiledTemplate(m_template));
 }
-
-string Whiskers::replace(
-	string const& _template,
-	StringMap const& _parameters,
-	map<string, vector<StringMap>> const& _listParameters
-)
-{
-	using namespace boost;
-	static regex listOrTag("<([^#/>]+)>|<#([^>]+)>(.*?)</\\2>");
-	return regex_replace(_template, listOrTag, [&](match_results<string::const_iterator> _match) -> string
-	{
-		string tagName(_match[1]);
-		if (!tagName.empty())
-		{
-			assertThrow(
-				_parameters.count(tagName),
-				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
-				"Template:\n" +
-				_template
-			);
-			return _parameters.at(tagName);
-		}
-		else
-		{
-			string listName(_match[2]);
-			string templ(_match[3]);
-			assertThrow(!listName.empty(), WhiskersError, "");
-			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
-			);
-			string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters));
-			return replacement;
-		}
-	});
-}
-
-Whiskers::StringMap Whiskers::joinMaps(
-	Whiskers::StringMap const& _a,
-	Whiskers::StringMap const& _b
-)
-{
-	Whiskers::StringMap ret = _a;
-	for (auto const& x: _b)
-		assertThrow(
-			ret.insert(x).second,
-			WhiskersError,
-			"Parameter collision"
-		);
-	return ret;
-}
-
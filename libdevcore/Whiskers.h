@@ -67,18 +67,11 @@ public:
 		std::vector<StringMap> const& _values
 	);
 
+	/// Renders the template. Each distinct template string is only parsed once
+	/// and the parsed form is shared by all instances.
 	std::string render() const;
 
 private:
-	static std::string replace(
-		std::string const& _template,
-		StringMap const& _parameters,
-		StringListMap const& _listParameters = StringListMap()
-	);
-
-	/// Joins the two maps throwing an exception if two keys are equal.
-	static StringMap joinMaps(StringMap const& _a, StringMap const& _b);
-
 	std::string m_template;
 	StringMap m_parameters;
 	StringListMap m_listParameters;
@@ -0,0 +1,154 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file Word256.cpp
+ * Fixed-width 256-bit integer arithmetic with EVM semantics.
+ */
+
+#include <libdevcore/Word256.h>
+
+using namespace std;
+
+namespace dev
+{
+
+void Word256::divMod(Word256 const& _a, Word256 const& _b, Word256& o_quotient, Word256& o_remainder)
+{
+	o_quotient = Word256();
+	if (_b.isZero())
+	{
+		o_remainder = Word256();
+		return;
+	}
+	if (_a < _b)
+	{
+		o_remainder = _a;
+		return;
+	}
+#if defined(__SIZEOF_INT128__)
+	if (_b.fitsUint64())
+	{
+		// Short division, one limb at a time.
+		uint64_t const divisor = _b.m_limbs[0];
+		uint64_t remainder = 0;
+		for (unsigned i = 4; i > 0; --i)
+		{
+			unsigned __int128 const dividend = (static_cast<unsigned __int128>(remainder) << 64) | _a.m_limbs[i - 1];
+			o_quotient.m_limbs[i - 1] = uint64_t(dividend / divisor);
+			remainder = uint64_t(dividend % divisor);
+		}
+		o_remainder = Word256(remainder);
+		return;
+	}
+#endif
+	// Binary long division. The number of steps is the difference of the bit lengths,
+	// which is small for the typical operands.
+	unsigned const shift = _a.bitLength() - _b.bitLength();
+	Word256 divisor = _b << shift;
+	o_remainder = _a;
+	for (unsigned i = shift + 1; i > 0; --i)
+	{
+		if (o_remainder >= divisor)
+		{
+			o_remainder -= divisor;
+			o_quotient.m_limbs[(i - 1) / 64] |= uint64_t(1) << ((i - 1) % 64);
+		}
+		divisor >>= 1;
+	}
+}
+
+bool signedLessThan(Word256 const& _a, Word256 const& _b)
+{
+	if (_a.isNegative() != _b.isNegative())
+		return _a.isNegative();
+	return _a < _b;
+}
+
+Word256 signedDiv(Word256 const& _a, Word256 const& _b)
+{
+	Word256 quotient = (_a.isNegative() ? -_a : _a) / (_b.isNegative() ? -_b : _b);
+	return _a.isNegative() != _b.isNegative() ? -quotient : quotient;
+}
+
+Word256 signedMod(Word256 const& _a, Word256 const& _b)
+{
+	// The sign of the result is the sign of the dividend.
+	Word256 remainder = (_a.isNegative() ? -_a : _a) % (_b.isNegative() ? -_b : _b);
+	return _a.isNegative() ? -remainder : remainder;
+}
+
+Word256 exp(Word256 _base, Word256 const& _exponent)
+{
+	Word256 result(1);
+	for (unsigned i = 0, length = _exponent.bitLength(); i < length; ++i)
+	{
+		if (_exponent.bit(i))
+			result = result * _base;
+		_base = _base * _base;
+	}
+	return result;
+}
+
+Word256 addMod(Word256 const& _a, Word256 const& _b, Word256 const& _modulus)
+{
+	if (_modulus.isZero())
+		return Word256();
+	Word256 const a = _a % _modulus;
+	Word256 const b = _b % _modulus;
+	// a + b < 2 * _modulus, so subtracting the modulus once is enough, also if the sum overflows.
+	Word256 sum = a + b;
+	if (sum < a || sum >= _modulus)
+		sum -= _modulus;
+	return sum;
+}
+
+Word256 mulMod(Word256 const& _a, Word256 const& _b, Word256 const& _modulus)
+{
+	if (_modulus.isZero())
+		return Word256();
+	Word256 const a = _a % _modulus;
+	Word256 const b = _b % _modulus;
+	if (a.fitsUint64() && b.fitsUint64())
+		// The product fits into 128 bits.
+		return (a * b) % _modulus;
+	// Double and add, keeping all intermediate values below the modulus.
+	Word256 result;
+	for (unsigned i = b.bitLength(); i > 0; --i)
+	{
+		result = addMod(result, result, _modulus);
+		if (b.bit(i - 1))
+			result = addMod(result, a, _modulus);
+	}
+	return result;
+}
+
+Word256 signExtend(Word256 const& _byteIndex, Word256 const& _value)
+{
+	if (_byteIndex >= 31)
+		return _value;
+	unsigned const testBit = unsigned(_byteIndex.limb(0)) * 8 + 7;
+	Word256 const mask = (Word256(1) << testBit) - 1;
+	return _value.bit(testBit) ? _value | ~mask : _value & mask;
+}
+
+Word256 byteAt(Word256 const& _index, Word256 const& _value)
+{
+	if (_index >= 32)
+		return Word256();
+	return (_value >> unsigned(8 * (31 - _index.limb(0)))) & 0xff;
+}
+
+}
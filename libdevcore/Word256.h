@@ -0,0 +1,295 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file Word256.h
+ * Fixed-width 256-bit integer arithmetic with EVM semantics.
+ */
+
+#pragma once
+
+#include <libdevcore/Common.h>
+
+#include <array>
+#include <cstdint>
+
+namespace dev
+{
+
+/**
+ * Unsigned 256-bit integer stored in four 64-bit limbs, least significant limb first.
+ * All operations wrap around modulo 2**256 and follow the semantics of the corresponding
+ * EVM instructions, in particular division and modulo by zero result in zero.
+ * Converts to and from u256. It is meant for code that evaluates many EVM operations, where
+ * u256 is slower and several operations have to fall back to bigint temporaries.
+ */
+class Word256
+{
+public:
+	Word256(): m_limbs{{0, 0, 0, 0}} {}
+	Word256(uint64_t _value): m_limbs{{_value, 0, 0, 0}} {}
+	explicit Word256(u256 const& _value);
+
+	explicit operator u256() const;
+
+	uint64_t limb(unsigned _index) const { return m_limbs[_index]; }
+	bool isZero() const { return (m_limbs[0] | m_limbs[1] | m_limbs[2] | m_limbs[3]) == 0; }
+	/// @returns true if the value fits into 64 bits.
+	bool fitsUint64() const { return (m_limbs[1] | m_limbs[2] | m_limbs[3]) == 0; }
+	/// @returns true if the most significant bit is set, i.e. the value is negative in two's complement.
+	bool isNegative() const { return (m_limbs[3] >> 63) != 0; }
+	bool bit(unsigned _index) const { return _index < 256 && ((m_limbs[_index / 64] >> (_index % 64)) & 1) != 0; }
+	/// @returns the number of bits needed to represent the value, zero for zero.
+	unsigned bitLength() const;
+
+	Word256 operator~() const { return Word256(~m_limbs[0], ~m_limbs[1], ~m_limbs[2], ~m_limbs[3]); }
+	Word256 operator-() const { return ~*this + 1; }
+
+	Word256& operator+=(Word256 const& _other);
+	Word256& operator-=(Word256 const& _other);
+	Word256& operator<<=(unsigned _shift);
+	Word256& operator>>=(unsigned _shift);
+
+	friend Word256 operator+(Word256 _a, Word256 const& _b) { return _a += _b; }
+	friend Word256 operator-(Word256 _a, Word256 const& _b) { return _a -= _b; }
+	friend Word256 operator*(Word256 const& _a, Word256 const& _b);
+	friend Word256 operator/(Word256 const& _a, Word256 const& _b);
+	friend Word256 operator%(Word256 const& _a, Word256 const& _b);
+	friend Word256 operator<<(Word256 _a, unsigned _shift) { return _a <<= _shift; }
+	friend Word256 operator>>(Word256 _a, unsigned _shift) { return _a >>= _shift; }
+	friend Word256 operator&(Word256 const& _a, Word256 const& _b)
+	{
+		return Word256(_a.m_limbs[0] & _b.m_limbs[0], _a.m_limbs[1] & _b.m_limbs[1], _a.m_limbs[2] & _b.m_limbs[2], _a.m_limbs[3] & _b.m_limbs[3]);
+	}
+	friend Word256 operator|(Word256 const& _a, Word256 const& _b)
+	{
+		return Word256(_a.m_limbs[0] | _b.m_limbs[0], _a.m_limbs[1] | _b.m_limbs[1], _a.m_limbs[2] | _b.m_limbs[2], _a.m_limbs[3] | _b.m_limbs[3]);
+	}
+	friend Word256 operator^(Word256 const& _a, Word256 const& _b)
+	{
+		return Word256(_a.m_limbs[0] ^ _b.m_limbs[0], _a.m_limbs[1] ^ _b.m_limbs[1], _a.m_limbs[2] ^ _b.m_limbs[2], _a.m_limbs[3] ^ _b.m_limbs[3]);
+	}
+
+	friend bool operator==(Word256 const& _a, Word256 const& _b) { return _a.m_limbs == _b.m_limbs; }
+	friend bool operator!=(Word256 const& _a, Word256 const& _b) { return _a.m_limbs != _b.m_limbs; }
+	friend bool operator<(Word256 const& _a, Word256 const& _b)
+	{
+		for (unsigned i = 4; i > 0; --i)
+			if (_a.m_limbs[i - 1] != _b.m_limbs[i - 1])
+				return _a.m_limbs[i - 1] < _b.m_limbs[i - 1];
+		return false;
+	}
+	friend bool operator>(Word256 const& _a, Word256 const& _b) { return _b < _a; }
+	friend bool operator<=(Word256 const& _a, Word256 const& _b) { return !(_b < _a); }
+	friend bool operator>=(Word256 const& _a, Word256 const& _b) { return !(_a < _b); }
+
+	/// Computes quotient and remainder of @a _a divided by @a _b, both zero if @a _b is zero.
+	static void divMod(Word256 const& _a, Word256 const& _b, Word256& o_quotient, Word256& o_remainder);
+
+private:
+	Word256(uint64_t _l0, uint64_t _l1, uint64_t _l2, uint64_t _l3): m_limbs{{_l0, _l1, _l2, _l3}} {}
+
+	/// Limbs, least significant first.
+	std::array<uint64_t, 4> m_limbs;
+};
+
+/// Comparison and division of two's complement signed numbers (SLT, SGT, SDIV, SMOD).
+bool signedLessThan(Word256 const& _a, Word256 const& _b);
+Word256 signedDiv(Word256 const& _a, Word256 const& _b);
+Word256 signedMod(Word256 const& _a, Word256 const& _b);
+/// @returns @a _base to the power of @a _exponent modulo 2**256 (EXP).
+Word256 exp(Word256 _base, Word256 const& _exponent);
+/// @returns (@a _a + @a _b) % @a _modulus without intermediate overflow, zero if the modulus is zero (ADDMOD).
+Word256 addMod(Word256 const& _a, Word256 const& _b, Word256 const& _modulus);
+/// @returns (@a _a * @a _b) % @a _modulus without intermediate overflow, zero if the modulus is zero (MULMOD).
+Word256 mulMod(Word256 const& _a, Word256 const& _b, Word256 const& _modulus);
+/// @returns @a _value sign-extended from its lowest @a _byteIndex + 1 bytes (SIGNEXTEND).
+Word256 signExtend(Word256 const& _byteIndex, Word256 const& _value);
+/// @returns the @a _index-th byte of @a _value counted from the most significant one (BYTE).
+Word256 byteAt(Word256 const& _index, Word256 const& _value);
+
+inline Word256::Word256(u256 const& _value): m_limbs{{0, 0, 0, 0}}
+{
+	using limb_type = boost::multiprecision::limb_type;
+	unsigned const limbBits = sizeof(limb_type) * 8;
+	auto const& backend = _value.backend();
+	for (unsigned i = 0; i < backend.size(); ++i)
+		m_limbs[i * limbBits / 64] |= uint64_t(backend.limbs()[i]) << (i * limbBits % 64);
+}
+
+inline Word256::operator u256() const
+{
+	using limb_type = boost::multiprecision::limb_type;
+	unsigned const limbBits = sizeof(limb_type) * 8;
+	u256 result;
+	auto& backend = result.backend();
+	backend.resize(256 / limbBits, 256 / limbBits);
+	for (unsigned i = 0; i < 256 / limbBits; ++i)
+		backend.limbs()[i] = limb_type(m_limbs[i * limbBits / 64] >> (i * limbBits % 64));
+	backend.normalize();
+	return result;
+}
+
+inline unsigned Word256::bitLength() const
+{
+	for (unsigned i = 4; i > 0; --i)
+		if (uint64_t limb = m_limbs[i - 1])
+		{
+#if defined(__GNUC__)
+			return 64 * i - unsigned(__builtin_clzll(limb));
+#else
+			unsigned length = 64 * (i - 1);
+			for (; limb; limb >>= 1)
+				++length;
+			return length;
+#endif
+		}
+	return 0;
+}
+
+inline Word256& Word256::operator+=(Word256 const& _other)
+{
+	uint64_t carry = 0;
+	for (unsigned i = 0; i < 4; ++i)
+	{
+		uint64_t sum = m_limbs[i] + carry;
+		carry = sum < carry ? 1 : 0;
+		m_limbs[i] = sum + _other.m_limbs[i];
+		carry += m_limbs[i] < sum ? 1 : 0;
+	}
+	return *this;
+}
+
+inline Word256& Word256::operator-=(Word256 const& _other)
+{
+	uint64_t borrow = 0;
+	for (unsigned i = 0; i < 4; ++i)
+	{
+		uint64_t difference = m_limbs[i] - _other.m_limbs[i];
+		uint64_t nextBorrow = m_limbs[i] < _other.m_limbs[i] ? 1 : 0;
+		nextBorrow += difference < borrow ? 1 : 0;
+		m_limbs[i] = difference - borrow;
+		borrow = nextBorrow;
+	}
+	return *this;
+}
+
+namespace detail
+{
+
+/// Computes the full 128-bit product of @a _a and @a _b.
+inline void multiply64(uint64_t _a, uint64_t _b, uint64_t& o_low, uint64_t& o_high)
+{
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 const product = static_cast<unsigned __int128>(_a) * _b;
+	o_low = uint64_t(product);
+	o_high = uint64_t(product >> 64);
+#else
+	uint64_t const aLow = _a & 0xffffffff;
+	uint64_t const aHigh = _a >> 32;
+	uint64_t const bLow = _b & 0xffffffff;
+	uint64_t const bHigh = _b >> 32;
+	uint64_t const lowLow = aLow * bLow;
+	uint64_t const highLow = aHigh * bLow;
+	uint64_t const lowHigh = aLow * bHigh;
+	uint64_t const middle = (lowLow >> 32) + (highLow & 0xffffffff) + (lowHigh & 0xffffffff);
+	o_low = (middle << 32) | (lowLow & 0xffffffff);
+	o_high = aHigh * bHigh + (highLow >> 32) + (lowHigh >> 32) + (middle >> 32);
+#endif
+}
+
+}
+
+inline Word256 operator*(Word256 const& _a, Word256 const& _b)
+{
+	// Schoolbook multiplication, skipping the partial products that only affect bits above 256.
+	Word256 result;
+	for (unsigned i = 0; i < 4; ++i)
+	{
+		uint64_t carry = 0;
+		for (unsigned j = 0; i + j < 4; ++j)
+		{
+			uint64_t low;
+			uint64_t high;
+			detail::multiply64(_a.m_limbs[i], _b.m_limbs[j], low, high);
+			low += carry;
+			high += low < carry ? 1 : 0;
+			uint64_t& target = result.m_limbs[i + j];
+			target += low;
+			high += target < low ? 1 : 0;
+			carry = high;
+		}
+	}
+	return result;
+}
+
+inline Word256 operator/(Word256 const& _a, Word256 const& _b)
+{
+	Word256 quotient;
+	Word256 remainder;
+	Word256::divMod(_a, _b, quotient, remainder);
+	return quotient;
+}
+
+inline Word256 operator%(Word256 const& _a, Word256 const& _b)
+{
+	Word256 quotient;
+	Word256 remainder;
+	Word256::divMod(_a, _b, quotient, remainder);
+	return remainder;
+}
+
+inline Word256& Word256::operator<<=(unsigned _shift)
+{
+	if (_shift >= 256)
+		return *this = Word256();
+	unsigned const limbShift = _shift / 64;
+	unsigned const bitShift = _shift % 64;
+	for (unsigned i = 4; i > 0; --i)
+	{
+		unsigned const target = i - 1;
+		uint64_t limb = 0;
+		if (target >= limbShift)
+		{
+			limb = m_limbs[target - limbShift] << bitShift;
+			if (bitShift && target > limbShift)
+				limb |= m_limbs[target - limbShift - 1] >> (64 - bitShift);
+		}
+		m_limbs[target] = limb;
+	}
+	return *this;
+}
+
+inline Word256& Word256::operator>>=(unsigned _shift)
+{
+	if (_shift >= 256)
+		return *this = Word256();
+	unsigned const limbShift = _shift / 64;
+	unsigned const bitShift = _shift % 64;
+	for (unsigned target = 0; target < 4; ++target)
+	{
+		uint64_t limb = 0;
+		if (target + limbShift < 4)
+		{
+			limb = m_limbs[target + limbShift] >> bitShift;
+			if (bitShift && target + limbShift + 1 < 4)
+				limb |= m_limbs[target + limbShift + 1] << (64 - bitShift);
+		}
+		m_limbs[target] = limb;
+	}
+	return *this;
+}
+
+}
@@ -22,6 +22,7 @@
 #include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/Assembly.h>
 #include <libevmasm/GasMeter.h>
+#include <libdevcore/Word256.h>
 using namespace std;
 using namespace dev;
 using namespace dev::eth;
@@ -198,9 +199,10 @@ AssemblyItems ComputeMethod::findRepresentation(u256 const& _value)
 		// Is not always better, try literal and decomposition method.
 		AssemblyItems routine{u256(_value)};
 		bigint bestGas = gasNeeded(routine);
+		Word256 const value(_value);
 		for (unsigned bits = 255; bits > 8 && m_maxSteps > 0; --bits)
 		{
-			unsigned gapDetector = unsigned(_value >> (bits - 8)) & 0x1ff;
+			unsigned gapDetector = unsigned((value >> (bits - 8)).limb(0)) & 0x1ff;
 			if (gapDetector != 0xff && gapDetector != 0x100)
 				continue;
 
@@ -183,7 +183,8 @@ string ExpressionClasses::fullDAGToString(ExpressionClasses::Id _id) const
 
 ExpressionClasses::Id ExpressionClasses::tryToSimplify(Expression const& _expr)
 {
-	static Rules rules;
+	// The rules store the expressions they matched, so every thread needs its own.
+	static thread_local Rules rules;
 
 	if (
 		!_expr.item ||
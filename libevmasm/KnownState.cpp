@@ -374,11 +374,15 @@ KnownState::Id KnownState::applyKeccak256(
 	// If all arguments are known constants, compute the Keccak-256 here
 	if (all_of(arguments.begin(), arguments.end(), [this](Id _a) { return !!m_expressionClasses->knownConstant(_a); }))
 	{
-		bytes data;
+		Keccak256 hasher;
+		size_t remaining = size_t(*l);
 		for (Id a: arguments)
-			data += toBigEndian(*m_expressionClasses->knownConstant(a));
-		data.resize(size_t(*l));
-		v = m_expressionClasses->find(AssemblyItem(u256(dev::keccak256(data)), _location));
+		{
+			h256 word(*m_expressionClasses->knownConstant(a));
+			hasher.update(word.ref().cropped(0, min<size_t>(remaining, 32)));
+			remaining -= min<size_t>(remaining, 32);
+		}
+		v = m_expressionClasses->find(AssemblyItem(u256(hasher.finalize()), _location));
 	}
 	else
 		v = m_expressionClasses->find(keccak256Item, {_start, _length}, true, m_sequenceNumber);
@@ -109,6 +109,15 @@ public:
 
 	/// @returns a shared pointer to a copy of this state.
 	std::shared_ptr<KnownState> copy() const { return std::make_shared<KnownState>(*this); }
+	/// @returns a shared pointer to a copy of this state that uses @a _expressionClasses, which
+	/// have to be a copy of the expression classes of this state (possibly with more classes).
+	/// Can be used to continue from this state concurrently with other copies.
+	std::shared_ptr<KnownState> copy(std::shared_ptr<ExpressionClasses> _expressionClasses) const
+	{
+		auto state = copy();
+		state->m_expressionClasses = std::move(_expressionClasses);
+		return state;
+	}
 
 	/// @returns true if the knowledge about the state of both objects is (known to be) equal.
 	bool operator==(KnownState const& _other) const;
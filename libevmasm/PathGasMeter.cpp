@@ -30,9 +30,28 @@ using namespace dev::eth;
 PathGasMeter::PathGasMeter(AssemblyItems const& _items, solidity::EVMVersion _evmVersion):
 	m_items(_items), m_evmVersion(_evmVersion)
 {
+	auto tagPositions = make_shared<map<u256, size_t>>();
 	for (size_t i = 0; i < m_items.size(); ++i)
 		if (m_items[i].type() == Tag)
-			m_tagPositions[m_items[i].data()] = i;
+			(*tagPositions)[m_items[i].data()] = i;
+	auto backwardJumpTargets = make_shared<set<size_t>>();
+	for (size_t i = 0; i < m_items.size(); ++i)
+		if (m_items[i].type() == PushTag && tagPositions->count(m_items[i].data()))
+		{
+			size_t target = tagPositions->at(m_items[i].data());
+			if (target <= i)
+				backwardJumpTargets->insert(target);
+		}
+	m_tagPositions = move(tagPositions);
+	m_backwardJumpTargets = move(backwardJumpTargets);
+}
+
+PathGasMeter::PathGasMeter(PathGasMeter const& _other):
+	m_tagPositions(_other.m_tagPositions),
+	m_backwardJumpTargets(_other.m_backwardJumpTargets),
+	m_items(_other.m_items),
+	m_evmVersion(_other.m_evmVersion)
+{
 }
 
 GasMeter::GasConsumption PathGasMeter::estimateMax(
@@ -40,29 +59,71 @@ GasMeter::GasConsumption PathGasMeter::estimateMax(
 	shared_ptr<KnownState> const& _state
 )
 {
+	GasPath path;
+	path.index = _startIndex;
+	path.state = _state;
+	return estimateMax(path);
+}
+
+GasMeter::GasConsumption PathGasMeter::estimateMax(GasPath const& _path)
+{
+	m_queue.clear();
+	m_highestGasUsagePerJumpdest.clear();
+	auto path = unique_ptr<GasPath>(new GasPath(_path));
+	path->state = _path.state->copy();
+	queue(move(path));
+	return handleQueue();
+}
+
+vector<GasPathBranch> PathGasMeter::unknownBranches(
+	size_t _startIndex,
+	shared_ptr<KnownState> const& _state
+)
+{
+	m_queue.clear();
+	m_highestGasUsagePerJumpdest.clear();
 	auto path = unique_ptr<GasPath>(new GasPath());
 	path->index = _startIndex;
 	path->state = _state->copy();
 	queue(move(path));
 
+	vector<GasPathBranch> branches;
+	while (!m_queue.empty())
+		if (handleQueueItem(&branches).isInfinite)
+			break;
+	return branches;
+}
+
+bool PathGasMeter::queue(std::unique_ptr<GasPath>&& _newPath)
+{
+	size_t index = _newPath->index;
+	bool revisitable = m_backwardJumpTargets->count(index);
+	auto record = m_highestGasUsagePerJumpdest.find(index);
+	if (record != m_highestGasUsagePerJumpdest.end() && _newPath->gas < record->second.gas)
+		return !revisitable || *record->second.state == *_newPath->state;
+
+	bool exact = true;
+	auto queued = m_queue.find(index);
+	if (revisitable && queued != m_queue.end())
+		exact = *queued->second->state == *_newPath->state;
+	// The state of the path changes while it is followed, so a copy is kept for comparisons.
+	m_highestGasUsagePerJumpdest[index] = JumpdestRecord{
+		_newPath->gas,
+		revisitable ? _newPath->state->copy() : nullptr
+	};
+	m_queue[index] = move(_newPath);
+	return exact;
+}
+
+GasMeter::GasConsumption PathGasMeter::handleQueue()
+{
 	GasMeter::GasConsumption gas;
 	while (!m_queue.empty() && !gas.isInfinite)
 		gas = max(gas, handleQueueItem());
 	return gas;
 }
 
-void PathGasMeter::queue(std::unique_ptr<GasPath>&& _newPath)
-{
-	if (
-		m_highestGasUsagePerJumpdest.count(_newPath->index) &&
-		_newPath->gas < m_highestGasUsagePerJumpdest.at(_newPath->index)
-	)
-		return;
-	m_highestGasUsagePerJumpdest[_newPath->index] = _newPath->gas;
-	m_queue[_newPath->index] = move(_newPath);
-}
-
-GasMeter::GasConsumption PathGasMeter::handleQueueItem()
+GasMeter::GasConsumption PathGasMeter::handleQueueItem(vector<GasPathBranch>* _unknownBranches)
 {
 	assertThrow(!m_queue.empty(), OptimizerException, "");
 
@@ -85,15 +146,16 @@ GasMeter::GasConsumption PathGasMeter::handleQueueItem()
 	for (; index < m_items.size() && !gas.isInfinite; ++index)
 	{
 		bool branchStops = false;
+		bool conditionKnown = true;
+		ExpressionClasses::Id condition = 0;
 		jumpTags.clear();
 		AssemblyItem const& item = m_items.at(index);
 		if (item.type() == Tag || item == AssemblyItem(Instruction::JUMPDEST))
 		{
-			// Do not allow any backwards jump. This is quite restrictive but should work for
-			// the simplest things.
-			if (path->visitedJumpdests.count(index))
+			// Only allow a limited number of backwards jumps. Loops terminate if their condition
+			// is eventually known, otherwise the limit is reached.
+			if (++path->jumpdestVisits[index] > c_maxJumpdestVisits)
 				return GasMeter::GasConsumption::infinite();
-			path->visitedJumpdests.insert(index);
 		}
 		else if (item == AssemblyItem(Instruction::JUMP))
 		{
@@ -104,7 +166,7 @@ GasMeter::GasConsumption PathGasMeter::handleQueueItem()
 		}
 		else if (item == AssemblyItem(Instruction::JUMPI))
 		{
-			ExpressionClasses::Id condition = state->relativeStackElement(-1);
+			condition = state->relativeStackElement(-1);
 			if (classes.knownNonZero(condition) || !classes.knownZero(condition))
 			{
 				jumpTags = state->tagsInExpression(state->relativeStackElement(0));
@@ -112,6 +174,7 @@ GasMeter::GasConsumption PathGasMeter::handleQueueItem()
 					return GasMeter::GasConsumption::infinite();
 			}
 			branchStops = classes.knownNonZero(condition);
+			conditionKnown = branchStops || classes.knownZero(condition);
 		}
 		else if (SemanticInformation::altersControlFlow(item))
 			branchStops = true;
@@ -122,13 +185,16 @@ GasMeter::GasConsumption PathGasMeter::handleQueueItem()
 		{
 			auto newPath = unique_ptr<GasPath>(new GasPath());
 			newPath->index = m_items.size();
-			if (m_tagPositions.count(tag))
-				newPath->index = m_tagPositions.at(tag);
+			if (m_tagPositions->count(tag))
+				newPath->index = m_tagPositions->at(tag);
 			newPath->gas = gas;
 			newPath->largestMemoryAccess = meter.largestMemoryAccess();
 			newPath->state = state->copy();
-			newPath->visitedJumpdests = path->visitedJumpdests;
-			queue(move(newPath));
+			newPath->jumpdestVisits = path->jumpdestVisits;
+			if (_unknownBranches && !conditionKnown)
+				_unknownBranches->push_back(GasPathBranch{condition, move(*newPath)});
+			else if (!queue(move(newPath)))
+				return GasMeter::GasConsumption::infinite();
 		}
 
 		if (branchStops)
@@ -22,9 +22,11 @@
 #pragma once
 
 #include <libevmasm/GasMeter.h>
+#include <libevmasm/ExpressionClasses.h>
 
 #include <libsolidity/interface/EVMVersion.h>
 
+#include <map>
 #include <set>
 #include <vector>
 #include <memory>
@@ -42,34 +44,78 @@ struct GasPath
 	std::shared_ptr<KnownState> state;
 	u256 largestMemoryAccess;
 	GasMeter::GasConsumption gas;
-	std::set<size_t> visitedJumpdests;
+	/// Number of times the path passed each jump destination.
+	std::map<size_t, unsigned> jumpdestVisits;
+};
+
+/// A path entering a jump destination through a conditional jump whose condition is not known.
+struct GasPathBranch
+{
+	ExpressionClasses::Id condition;
+	GasPath path;
 };
 
 /**
  * Computes an upper bound on the gas usage of a computation starting at a certain position in
  * a list of AssemblyItems in a given state until the computation stops.
  * Can be used to estimate the gas usage of functions on any given input.
+ * The same meter can be used for multiple estimations on the same items.
  */
 class PathGasMeter
 {
 public:
 	explicit PathGasMeter(AssemblyItems const& _items, solidity::EVMVersion _evmVersion);
+	/// Creates a meter for the same items that shares the positions of their tags with @a _other.
+	/// Both meters can be used concurrently.
+	PathGasMeter(PathGasMeter const& _other);
 
 	GasMeter::GasConsumption estimateMax(size_t _startIndex, std::shared_ptr<KnownState> const& _state);
+	/// @returns an upper bound on the gas usage of all continuations of the given path.
+	GasMeter::GasConsumption estimateMax(GasPath const& _path);
+
+	/// Follows all paths starting at the given position, but stops at conditional jumps
+	/// whose condition is not known.
+	/// @returns the paths at the destinations of these jumps, in the order they were reached.
+	/// Can be used to analyse code shared by many computations (like the function selector)
+	/// only once and to estimate the computations separately afterwards.
+	std::vector<GasPathBranch> unknownBranches(size_t _startIndex, std::shared_ptr<KnownState> const& _state);
+
+	/// Maximum number of times a path can pass the same jump destination. This allows loops
+	/// with a constant number of iterations and repeated calls to internal functions.
+	static unsigned const c_maxJumpdestVisits = 32;
 
 private:
+	/// The highest gas usage of a path queued at a jump destination and, if the destination
+	/// can be reached again by a backwards jump, the state of that path.
+	struct JumpdestRecord
+	{
+		GasMeter::GasConsumption gas;
+		std::shared_ptr<KnownState const> state;
+	};
+
 	/// Adds a new path item to the queue, but only if we do not already have
 	/// a higher gas usage at that point.
 	/// This is not exact as different state might influence higher gas costs at a later
 	/// point in time, but it greatly reduces computational overhead.
-	void queue(std::unique_ptr<GasPath>&& _newPath);
-	GasMeter::GasConsumption handleQueueItem();
+	/// At the targets of backwards jumps, however, the state can decide whether a loop
+	/// terminates, so a path that is dropped there in favour of a path with a different
+	/// state makes the estimate unbounded.
+	/// @returns false if the estimate is unbounded because of a dropped path.
+	bool queue(std::unique_ptr<GasPath>&& _newPath);
+	GasMeter::GasConsumption handleQueue();
+	/// Follows the path with the highest index in the queue until it stops.
+	/// If @a _unknownBranches is not null, paths at conditional jumps with unknown condition
+	/// are stored there instead of being queued.
+	GasMeter::GasConsumption handleQueueItem(std::vector<GasPathBranch>* _unknownBranches = nullptr);
 
 	/// Map of jumpdest -> gas path, so not really a queue. We only have one queued up
 	/// item per jumpdest, because of the behaviour of `queue` above.
 	std::map<size_t, std::unique_ptr<GasPath>> m_queue;
-	std::map<size_t, GasMeter::GasConsumption> m_highestGasUsagePerJumpdest;
-	std::map<u256, size_t> m_tagPositions;
+	std::map<size_t, JumpdestRecord> m_highestGasUsagePerJumpdest;
+	std::shared_ptr<std::map<u256, size_t> const> m_tagPositions;
+	/// Positions of the tags that are pushed after their position, i.e. of loop heads
+	/// and other jump destinations that can be reached again.
+	std::shared_ptr<std::set<size_t> const> m_backwardJumpTargets;
 	AssemblyItems const& m_items;
 	solidity::EVMVersion m_evmVersion;
 };
@@ -28,22 +28,13 @@
 #include <libevmasm/SimplificationRule.h>
 
 #include <libdevcore/CommonData.h>
+#include <libdevcore/Word256.h>
 
 namespace dev
 {
 namespace solidity
 {
 
-template <class S> S divWorkaround(S const& _a, S const& _b)
-{
-	return (S)(bigint(_a) / bigint(_b));
-}
-
-template <class S> S modWorkaround(S const& _a, S const& _b)
-{
-	return (S)(bigint(_a) % bigint(_b));
-}
-
 /// @returns a list of simplification rules given certain match placeholders.
 /// A, B and C should represent constants, X and Y arbitrary expressions.
 /// The simplifications should neven change the order of evaluation of
@@ -63,36 +54,30 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleList(
 		{{Instruction::ADD, {A, B}}, [=]{ return A.d() + B.d(); }, false},
 		{{Instruction::MUL, {A, B}}, [=]{ return A.d() * B.d(); }, false},
 		{{Instruction::SUB, {A, B}}, [=]{ return A.d() - B.d(); }, false},
-		{{Instruction::DIV, {A, B}}, [=]{ return B.d() == 0 ? 0 : divWorkaround(A.d(), B.d()); }, false},
-		{{Instruction::SDIV, {A, B}}, [=]{ return B.d() == 0 ? 0 : s2u(divWorkaround(u2s(A.d()), u2s(B.d()))); }, false},
-		{{Instruction::MOD, {A, B}}, [=]{ return B.d() == 0 ? 0 : modWorkaround(A.d(), B.d()); }, false},
-		{{Instruction::SMOD, {A, B}}, [=]{ return B.d() == 0 ? 0 : s2u(modWorkaround(u2s(A.d()), u2s(B.d()))); }, false},
-		{{Instruction::EXP, {A, B}}, [=]{ return u256(boost::multiprecision::powm(bigint(A.d()), bigint(B.d()), bigint(1) << 256)); }, false},
+		{{Instruction::DIV, {A, B}}, [=]{ return u256(Word256(A.d()) / Word256(B.d())); }, false},
+		{{Instruction::SDIV, {A, B}}, [=]{ return u256(signedDiv(Word256(A.d()), Word256(B.d()))); }, false},
+		{{Instruction::MOD, {A, B}}, [=]{ return u256(Word256(A.d()) % Word256(B.d())); }, false},
+		{{Instruction::SMOD, {A, B}}, [=]{ return u256(signedMod(Word256(A.d()), Word256(B.d()))); }, false},
+		{{Instruction::EXP, {A, B}}, [=]{ return u256(exp(Word256(A.d()), Word256(B.d()))); }, false},
 		{{Instruction::NOT, {A}}, [=]{ return ~A.d(); }, false},
 		{{Instruction::LT, {A, B}}, [=]() -> u256 { return A.d() < B.d() ? 1 : 0; }, false},
 		{{Instruction::GT, {A, B}}, [=]() -> u256 { return A.d() > B.d() ? 1 : 0; }, false},
-		{{Instruction::SLT, {A, B}}, [=]() -> u256 { return u2s(A.d()) < u2s(B.d()) ? 1 : 0; }, false},
-		{{Instruction::SGT, {A, B}}, [=]() -> u256 { return u2s(A.d()) > u2s(B.d()) ? 1 : 0; }, false},
+		{{Instruction::SLT, {A, B}}, [=]() -> u256 { return signedLessThan(Word256(A.d()), Word256(B.d())) ? 1 : 0; }, false},
+		{{Instruction::SGT, {A, B}}, [=]() -> u256 { return signedLessThan(Word256(B.d()), Word256(A.d())) ? 1 : 0; }, false},
 		{{Instruction::EQ, {A, B}}, [=]() -> u256 { return A.d() == B.d() ? 1 : 0; }, false},
 		{{Instruction::ISZERO, {A}}, [=]() -> u256 { return A.d() == 0 ? 1 : 0; }, false},
 		{{Instruction::AND, {A, B}}, [=]{ return A.d() & B.d(); }, false},
 		{{Instruction::OR, {A, B}}, [=]{ return A.d() | B.d(); }, false},
 		{{Instruction::XOR, {A, B}}, [=]{ return A.d() ^ B.d(); }, false},
-		{{Instruction::BYTE, {A, B}}, [=]{ return A.d() >= 32 ? 0 : (B.d() >> unsigned(8 * (31 - A.d()))) & 0xff; }, false},
-		{{Instruction::ADDMOD, {A, B, C}}, [=]{ return C.d() == 0 ? 0 : u256((bigint(A.d()) + bigint(B.d())) % C.d()); }, false},
-		{{Instruction::MULMOD, {A, B, C}}, [=]{ return C.d() == 0 ? 0 : u256((bigint(A.d()) * bigint(B.d())) % C.d()); }, false},
+		{{Instruction::BYTE, {A, B}}, [=]{ return u256(byteAt(Word256(A.d()), Word256(B.d()))); }, false},
+		{{Instruction::ADDMOD, {A, B, C}}, [=]{ return u256(addMod(Word256(A.d()), Word256(B.d()), Word256(C.d()))); }, false},
+		{{Instruction::MULMOD, {A, B, C}}, [=]{ return u256(mulMod(Word256(A.d()), Word256(B.d()), Word256(C.d()))); }, false},
 		{{Instruction::MULMOD, {A, B, C}}, [=]{ return A.d() * B.d(); }, false},
-		{{Instruction::SIGNEXTEND, {A, B}}, [=]() -> u256 {
-			if (A.d() >= 31)
-				return B.d();
-			unsigned testBit = unsigned(A.d()) * 8 + 7;
-			u256 mask = (u256(1) << testBit) - 1;
-			return u256(boost::multiprecision::bit_test(B.d(), testBit) ? B.d() | ~mask : B.d() & mask);
-		}, false},
+		{{Instruction::SIGNEXTEND, {A, B}}, [=]{ return u256(signExtend(Word256(A.d()), Word256(B.d()))); }, false},
 		{{Instruction::SHL, {A, B}}, [=]{
 			if (A.d() > 255)
 				return u256(0);
-			return u256(bigint(B.d()) << unsigned(A.d()));
+			return u256(Word256(B.d()) << unsigned(A.d()));
 		}, false},
 		{{Instruction::SHR, {A, B}}, [=]{
 			if (A.d() > 255)
@@ -38,10 +38,10 @@ Declaration const* DeclarationContainer::conflictingDeclaration(
 		_name = &_declaration.name();
 	solAssert(!_name->empty(), "");
 	vector<Declaration const*> declarations;
-	if (m_declarations.count(*_name))
-		declarations += m_declarations.at(*_name);
-	if (m_invisibleDeclarations.count(*_name))
-		declarations += m_invisibleDeclarations.at(*_name);
+	if (auto visible = m_declarations.find(*_name))
+		declarations += *visible;
+	if (auto invisible = m_invisibleDeclarations.find(*_name))
+		declarations += *invisible;
 
 	if (
 		dynamic_cast<FunctionDefinition const*>(&_declaration) ||
@@ -87,12 +87,14 @@ Declaration const* DeclarationContainer::conflictingDeclaration(
 
 void DeclarationContainer::activateVariable(ASTString const& _name)
 {
+	auto invisible = m_invisibleDeclarations.find(_name);
 	solAssert(
-		m_invisibleDeclarations.count(_name) && m_invisibleDeclarations.at(_name).size() == 1,
+		invisible && invisible->size() == 1,
 		"Tried to activate a non-inactive variable or multiple inactive variables with the same name."
 	);
-	solAssert(m_declarations.count(_name) == 0 || m_declarations.at(_name).empty(), "");
-	m_declarations[_name].emplace_back(m_invisibleDeclarations.at(_name).front());
+	auto visible = m_declarations.find(_name);
+	solAssert(!visible || visible->empty(), "");
+	m_declarations[_name].emplace_back(invisible->front());
 	m_invisibleDeclarations.erase(_name);
 }
 
@@ -126,14 +128,22 @@ bool DeclarationContainer::registerDeclaration(
 vector<Declaration const*> DeclarationContainer::resolveName(ASTString const& _name, bool _recursive, bool _alsoInvisible) const
 {
 	solAssert(!_name.empty(), "Attempt to resolve empty name.");
-	vector<Declaration const*> result;
-	if (m_declarations.count(_name))
-		result = m_declarations.at(_name);
-	if (_alsoInvisible && m_invisibleDeclarations.count(_name))
-		result += m_invisibleDeclarations.at(_name);
-	if (result.empty() && _recursive && m_enclosingContainer)
-		result = m_enclosingContainer->resolveName(_name, true, _alsoInvisible);
-	return result;
+	for (
+		DeclarationContainer const* container = this;
+		container;
+		container = _recursive ? container->m_enclosingContainer : nullptr
+	)
+	{
+		vector<Declaration const*> result;
+		if (auto visible = container->m_declarations.find(_name))
+			result = *visible;
+		if (_alsoInvisible)
+			if (auto invisible = container->m_invisibleDeclarations.find(_name))
+				result += *invisible;
+		if (!result.empty())
+			return result;
+	}
+	return {};
 }
 
 vector<ASTString> DeclarationContainer::similarNames(ASTString const& _name) const
@@ -142,21 +152,34 @@ vector<ASTString> DeclarationContainer::similarNames(ASTString const& _name) con
 
 	vector<ASTString> similar;
 
-	for (auto const& declaration: m_declarations)
-	{
-		string const& declarationName = declaration.first;
-		if (stringWithinDistance(_name, declarationName, MAXIMUM_EDIT_DISTANCE))
-			similar.push_back(declarationName);
-	}
-	for (auto const& declaration: m_invisibleDeclarations)
-	{
-		string const& declarationName = declaration.first;
-		if (stringWithinDistance(_name, declarationName, MAXIMUM_EDIT_DISTANCE))
-			similar.push_back(declarationName);
-	}
-
-	if (m_enclosingContainer)
-		similar += m_enclosingContainer->similarNames(_name);
+	for (DeclarationContainer const* container = this; container; container = container->m_enclosingContainer)
+		for (auto const* declarations: {&container->m_declarations, &container->m_invisibleDeclarations})
+			for (auto const& declaration: declarations->ordered())
+			{
+				string const& declarationName = declaration.first;
+				if (stringWithinDistance(_name, declarationName, MAXIMUM_EDIT_DISTANCE))
+					similar.push_back(declarationName);
+			}
 
 	return similar;
 }
+
+vector<Declaration const*> const* DeclarationContainer::NameTable::find(ASTString const& _name) const
+{
+	auto it = m_index.find(_name);
+	return it == m_index.end() ? nullptr : it->second;
+}
+
+vector<Declaration const*>& DeclarationContainer::NameTable::operator[](ASTString const& _name)
+{
+	vector<Declaration const*>*& entry = m_index[_name];
+	if (!entry)
+		entry = &m_ordered[_name];
+	return *entry;
+}
+
+void DeclarationContainer::NameTable::erase(ASTString const& _name)
+{
+	m_index.erase(_name);
+	m_ordered.erase(_name);
+}
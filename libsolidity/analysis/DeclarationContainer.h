@@ -24,6 +24,8 @@
 
 #include <map>
 #include <set>
+#include <unordered_map>
+#include <vector>
 #include <boost/noncopyable.hpp>
 
 #include <libsolidity/ast/ASTForward.h>
@@ -54,7 +56,7 @@ public:
 	std::vector<Declaration const*> resolveName(ASTString const& _name, bool _recursive = false, bool _alsoInvisible = false) const;
 	ASTNode const* enclosingNode() const { return m_enclosingNode; }
 	DeclarationContainer const* enclosingContainer() const { return m_enclosingContainer; }
-	std::map<ASTString, std::vector<Declaration const*>> const& declarations() const { return m_declarations; }
+	std::map<ASTString, std::vector<Declaration const*>> const& declarations() const { return m_declarations.ordered(); }
 	/// @returns whether declaration is valid, and if not also returns previous declaration.
 	Declaration const* conflictingDeclaration(Declaration const& _declaration, ASTString const* _name = nullptr) const;
 
@@ -67,10 +69,30 @@ public:
 	std::vector<ASTString> similarNames(ASTString const& _name) const;
 
 private:
+	/**
+	 * Mapping from names to declarations that is ordered by name for iteration
+	 * and additionally indexed by a hash table for lookups.
+	 */
+	class NameTable: private boost::noncopyable
+	{
+	public:
+		/// @returns the declarations registered under @a _name or nullptr if there is no entry.
+		std::vector<Declaration const*> const* find(ASTString const& _name) const;
+		/// @returns the declarations registered under @a _name, creating an empty entry if needed.
+		std::vector<Declaration const*>& operator[](ASTString const& _name);
+		void erase(ASTString const& _name);
+		std::map<ASTString, std::vector<Declaration const*>> const& ordered() const { return m_ordered; }
+
+	private:
+		std::map<ASTString, std::vector<Declaration const*>> m_ordered;
+		/// Points into the (node-based and thus stable) entries of m_ordered.
+		std::unordered_map<ASTString, std::vector<Declaration const*>*> m_index;
+	};
+
 	ASTNode const* m_enclosingNode;
 	DeclarationContainer const* m_enclosingContainer;
-	std::map<ASTString, std::vector<Declaration const*>> m_declarations;
-	std::map<ASTString, std::vector<Declaration const*>> m_invisibleDeclarations;
+	NameTable m_declarations;
+	NameTable m_invisibleDeclarations;
 };
 
 }
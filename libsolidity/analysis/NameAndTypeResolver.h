@@ -23,6 +23,7 @@
 #pragma once
 
 #include <map>
+#include <unordered_map>
 #include <list>
 #include <boost/noncopyable.hpp>
 #include <libsolidity/analysis/DeclarationContainer.h>
@@ -49,7 +50,7 @@ public:
 	/// are filled during the lifetime of this object.
 	NameAndTypeResolver(
 		std::vector<Declaration const*> const& _globals,
-		std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& _scopes,
+		std::unordered_map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& _scopes,
 		ErrorReporter& _errorReporter
 	);
 	/// Registers all declarations found in the AST node, usually a source unit.
@@ -122,7 +123,7 @@ private:
 	/// where nullptr denotes the global scope. Note that structs are not scope since they do
 	/// not contain code.
 	/// Aliases (for example `import "x" as y;`) create multiple pointers to the same scope.
-	std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& m_scopes;
+	std::unordered_map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& m_scopes;
 
 	DeclarationContainer* m_currentScope = nullptr;
 	ErrorReporter& m_errorReporter;
@@ -140,7 +141,7 @@ public:
 	/// @param _currentScope should be nullptr if we start at SourceUnit, but can be different
 	/// to inject new declarations into an existing scope, used by snippets.
 	DeclarationRegistrationHelper(
-		std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& _scopes,
+		std::unordered_map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& _scopes,
 		ASTNode& _astRoot,
 		bool _useC99Scoping,
 		ErrorReporter& _errorReporter,
@@ -191,7 +192,7 @@ private:
 	std::string currentCanonicalName() const;
 
 	bool m_useC99Scoping = false;
-	std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& m_scopes;
+	std::unordered_map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& m_scopes;
 	ASTNode const* m_currentScope = nullptr;
 	VariableScope* m_currentFunction = nullptr;
 	ErrorReporter& m_errorReporter;
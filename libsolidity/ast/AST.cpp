@@ -39,16 +39,43 @@ class IDDispenser
 {
 public:
 	static size_t next() { return ++instance(); }
-	static void reset() { instance() = 0; }
+	static void reset(size_t _lastID) { instance() = _lastID; }
+	static size_t last() { return instance(); }
 private:
 	static size_t& instance()
 	{
-		static IDDispenser dispenser;
-		return dispenser.id;
+		static thread_local size_t id = 0;
+		return id;
 	}
-	size_t id = 0;
 };
 
+namespace
+{
+
+/// Collects all nodes below a node, including the identifiers of import aliases,
+/// which are not visited by ImportDirective::accept.
+class NodeCollector: public ASTVisitor
+{
+public:
+	std::vector<ASTNode*> nodes;
+
+	bool visit(ImportDirective& _import) override
+	{
+		for (auto const& alias: _import.symbolAliases())
+			nodes.push_back(alias.first.get());
+		return visitNode(_import);
+	}
+
+protected:
+	bool visitNode(ASTNode& _node) override
+	{
+		nodes.push_back(&_node);
+		return true;
+	}
+};
+
+}
+
 ASTNode::ASTNode(SourceLocation const& _location):
 	m_id(IDDispenser::next()),
 	m_location(_location)
@@ -60,9 +87,24 @@ ASTNode::~ASTNode()
 	delete m_annotation;
 }
 
-void ASTNode::resetID()
+void ASTNode::resetID(size_t _lastID)
+{
+	IDDispenser::reset(_lastID);
+}
+
+size_t ASTNode::lastID()
+{
+	return IDDispenser::last();
+}
+
+void ASTNode::shiftIDs(size_t _offset)
 {
-	IDDispenser::reset();
+	NodeCollector collector;
+	accept(collector);
+	sort(collector.nodes.begin(), collector.nodes.end());
+	collector.nodes.erase(unique(collector.nodes.begin(), collector.nodes.end()), collector.nodes.end());
+	for (ASTNode* node: collector.nodes)
+		node->m_id += _offset;
 }
 
 ASTAnnotation& ASTNode::annotation() const
@@ -109,6 +151,49 @@ TypePointer ImportDirective::type() const
 	return make_shared<ModuleType>(*annotation().sourceUnit);
 }
 
+string const& Declaration::cachedExternalSignature(function<string()> const& _compute) const
+{
+	lock_guard<recursive_mutex> lock(lazyCacheMutex());
+	if (!m_externalSignature)
+		m_externalSignature.reset(new ExternalSignature{_compute(), h256(), false});
+	return m_externalSignature->signature;
+}
+
+h256 const& Declaration::cachedExternalSignatureHash(function<string()> const& _compute) const
+{
+	lock_guard<recursive_mutex> lock(lazyCacheMutex());
+	cachedExternalSignature(_compute);
+	if (!m_externalSignature->hashed)
+	{
+		m_externalSignature->hash = dev::keccak256(m_externalSignature->signature);
+		m_externalSignature->hashed = true;
+	}
+	return m_externalSignature->hash;
+}
+
+void Declaration::hashExternalSignatures(vector<Declaration const*> const& _declarations)
+{
+	lock_guard<recursive_mutex> lock(lazyCacheMutex());
+	vector<ExternalSignature*> unhashed;
+	vector<bytesConstRef> signatures;
+	for (Declaration const* declaration: _declarations)
+	{
+		ExternalSignature* externalSignature = declaration->m_externalSignature.get();
+		solAssert(externalSignature, "External signature has not been built.");
+		if (!externalSignature->hashed)
+		{
+			unhashed.push_back(externalSignature);
+			signatures.emplace_back(externalSignature->signature);
+		}
+	}
+	vector<h256> hashes = keccak256Batch(signatures);
+	for (size_t i = 0; i < unhashed.size(); ++i)
+	{
+		unhashed[i]->hash = hashes[i];
+		unhashed[i]->hashed = true;
+	}
+}
+
 map<FixedHash<4>, FunctionTypePointer> ContractDefinition::interfaceFunctions() const
 {
 	auto exportedFunctionList = interfaceFunctionList();
@@ -150,6 +235,7 @@ FunctionDefinition const* ContractDefinition::fallbackFunction() const
 
 vector<EventDefinition const*> const& ContractDefinition::interfaceEvents() const
 {
+	lock_guard<recursive_mutex> lock(lazyCacheMutex());
 	if (!m_interfaceEvents)
 	{
 		set<string> eventsSeen;
@@ -175,10 +261,11 @@ vector<EventDefinition const*> const& ContractDefinition::interfaceEvents() cons
 
 vector<pair<FixedHash<4>, FunctionTypePointer>> const& ContractDefinition::interfaceFunctionList() const
 {
+	lock_guard<recursive_mutex> lock(lazyCacheMutex());
 	if (!m_interfaceFunctionList)
 	{
 		set<string> signaturesSeen;
-		m_interfaceFunctionList.reset(new vector<pair<FixedHash<4>, FunctionTypePointer>>());
+		vector<FunctionTypePointer> interfaceFunctions;
 		for (ContractDefinition const* contract: annotation().linearizedBaseContracts)
 		{
 			vector<FunctionTypePointer> functions;
@@ -197,17 +284,25 @@ vector<pair<FixedHash<4>, FunctionTypePointer>> const& ContractDefinition::inter
 				if (signaturesSeen.count(functionSignature) == 0)
 				{
 					signaturesSeen.insert(functionSignature);
-					FixedHash<4> hash(dev::keccak256(functionSignature));
-					m_interfaceFunctionList->push_back(make_pair(hash, fun));
+					interfaceFunctions.push_back(fun);
 				}
 			}
 		}
+		// The selectors of all functions of the contract are hashed together.
+		vector<Declaration const*> declarations;
+		for (FunctionTypePointer const& fun: interfaceFunctions)
+			declarations.push_back(&fun->declaration());
+		Declaration::hashExternalSignatures(declarations);
+		m_interfaceFunctionList.reset(new vector<pair<FixedHash<4>, FunctionTypePointer>>());
+		for (FunctionTypePointer const& fun: interfaceFunctions)
+			m_interfaceFunctionList->push_back(make_pair(FixedHash<4>(fun->externalSignatureHash()), fun));
 	}
 	return *m_interfaceFunctionList;
 }
 
 vector<Declaration const*> const& ContractDefinition::inheritableMembers() const
 {
+	lock_guard<recursive_mutex> lock(lazyCacheMutex());
 	if (!m_inheritableMembers)
 	{
 		set<string> memberSeen;
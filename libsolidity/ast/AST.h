@@ -37,6 +37,7 @@
 
 #include <boost/noncopyable.hpp>
 
+#include <functional>
 #include <string>
 #include <vector>
 #include <memory>
@@ -63,8 +64,16 @@ public:
 
 	/// @returns an identifier of this AST node that is unique for a single compilation run.
 	size_t id() const { return m_id; }
-	/// Resets the global ID counter. This invalidates all previous IDs.
-	static void resetID();
+	/// Resets the ID counter so that the next node gets the ID @a _lastID + 1.
+	/// This invalidates all previous IDs. Every thread has its own counter,
+	/// so that source units can be parsed concurrently.
+	static void resetID(size_t _lastID = 0);
+	/// @returns the ID of the node most recently created by the current thread.
+	static size_t lastID();
+	/// Adds @a _offset to the IDs of this node and of all nodes below it. Used to
+	/// arrange the IDs of concurrently parsed source units as if they were parsed
+	/// one after another.
+	void shiftIDs(size_t _offset);
 
 	virtual void accept(ASTVisitor& _visitor) = 0;
 	virtual void accept(ASTConstVisitor& _visitor) const = 0;
@@ -99,7 +108,7 @@ public:
 	///@}
 
 protected:
-	size_t const m_id = 0;
+	size_t m_id = 0;
 	/// Annotation - is specialised in derived classes, is created upon request (because of polymorphism).
 	mutable ASTAnnotation* m_annotation = nullptr;
 
@@ -221,12 +230,32 @@ public:
 	/// @returns null when it is not accessible as a function.
 	virtual FunctionTypePointer functionType(bool /*_internal*/) const { return {}; }
 
+	/// @returns the external signature of the function, getter or event declared here, using
+	/// @a _compute to build it on first use. This way each signature is built and hashed only
+	/// once per compilation, however many function types refer to the declaration.
+	std::string const& cachedExternalSignature(std::function<std::string()> const& _compute) const;
+	/// @returns the Keccak-256 hash of the signature returned by cachedExternalSignature,
+	/// computing it on first use.
+	h256 const& cachedExternalSignatureHash(std::function<std::string()> const& _compute) const;
+	/// Computes the hashes of the cached external signatures of @a _declarations that have
+	/// not been hashed yet in one batch.
+	static void hashExternalSignatures(std::vector<Declaration const*> const& _declarations);
+
 protected:
 	virtual Visibility defaultVisibility() const { return Visibility::Public; }
 
 private:
+	struct ExternalSignature
+	{
+		std::string signature;
+		h256 hash;
+		bool hashed;
+	};
+
 	ASTPointer<ASTString> m_name;
 	Visibility m_visibility;
+
+	mutable std::unique_ptr<ExternalSignature> m_externalSignature;
 };
 
 /**
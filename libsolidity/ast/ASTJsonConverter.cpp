@@ -21,6 +21,7 @@
 
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <boost/algorithm/string/join.hpp>
+#include <libdevcore/JSON.h>
 #include <libdevcore/UTF8.h>
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/inlineasm/AsmData.h>
@@ -33,6 +34,13 @@ namespace dev
 namespace solidity
 {
 
+namespace
+{
+/// Name of the only member of placeholder objects, which cannot occur in the AST output.
+/// Its value is the index of the placeholder in m_placeholders.
+string const c_placeholderMember = "#node";
+}
+
 ASTJsonConverter::ASTJsonConverter(bool _legacy, map<string, unsigned> _sourceIndices):
 	m_legacy(_legacy),
 	m_sourceIndices(_sourceIndices)
@@ -67,6 +75,12 @@ void ASTJsonConverter::setJsonNode(
 		m_currentValue["nodeType"] = _nodeType;
 		for (auto& e: _attributes)
 			m_currentValue[e.first] = std::move(e.second);
+		if (m_writer)
+		{
+			// Writing the children converts them, which overwrites m_currentValue.
+			Json::Value node = std::move(m_currentValue);
+			writeValue(node);
+		}
 	}
 	else
 	{
@@ -189,10 +203,74 @@ void ASTJsonConverter::print(ostream& _stream, ASTNode const& _node)
 
 Json::Value&& ASTJsonConverter::toJson(ASTNode const& _node)
 {
-	_node.accept(*this);
+	if (m_writer)
+		m_currentValue = placeholder(_node);
+	else
+		_node.accept(*this);
 	return std::move(m_currentValue);
 }
 
+void ASTJsonConverter::write(JsonStreamWriter& _writer, ASTNode const& _node)
+{
+	if (m_legacy)
+	{
+		_writer.value(toJson(_node));
+		return;
+	}
+	m_writer = &_writer;
+	ScopeGuard resetWriter([&]()
+	{
+		m_writer = nullptr;
+		m_placeholders.clear();
+	});
+	_node.accept(*this);
+}
+
+void ASTJsonConverter::write(JsonTreeWriter& _writer, ASTNode const& _node)
+{
+	_writer.value(toJson(_node));
+}
+
+Json::Value ASTJsonConverter::placeholder(ASTNode const& _node)
+{
+	// The node is converted later, so the context it is converted in has to be stored.
+	Json::Value placeholder(Json::objectValue);
+	placeholder[c_placeholderMember] = Json::UInt64(m_placeholders.size());
+	m_placeholders.push_back({&_node, m_inEvent});
+	return placeholder;
+}
+
+void ASTJsonConverter::writeValue(Json::Value const& _value)
+{
+	solAssert(m_writer, "");
+	if (_value.isObject() && _value.size() == 1 && _value.isMember(c_placeholderMember))
+	{
+		// Converting the node adds placeholders, which can reallocate the table.
+		Placeholder placeholder = m_placeholders.at(_value[c_placeholderMember].asUInt64());
+		m_inEvent = placeholder.inEvent;
+		placeholder.node->accept(*this);
+	}
+	else if (_value.isObject())
+	{
+		m_writer->beginObject();
+		for (auto it = _value.begin(); it != _value.end(); ++it)
+		{
+			m_writer->member(it.name());
+			writeValue(*it);
+		}
+		m_writer->endObject();
+	}
+	else if (_value.isArray())
+	{
+		m_writer->beginArray();
+		for (auto const& element: _value)
+			writeValue(element);
+		m_writer->endArray();
+	}
+	else
+		m_writer->value(_value);
+}
+
 bool ASTJsonConverter::visit(SourceUnit const& _node)
 {
 	Json::Value exportedSymbols = Json::objectValue;
@@ -257,7 +335,7 @@ bool ASTJsonConverter::visit(ContractDefinition const& _node)
 		make_pair("fullyImplemented", _node.annotation().unimplementedFunctions.empty()),
 		make_pair("linearizedBaseContracts", getContainerIds(_node.annotation().linearizedBaseContracts)),
 		make_pair("baseContracts", toJson(_node.baseContracts())),
-		make_pair("contractDependencies", getContainerIds(_node.annotation().contractDependencies)),
+		make_pair("contractDependencies", getContainerIds(_node.annotation().contractDependencies, true)),
 		make_pair("nodes", toJson(_node.subNodes())),
 		make_pair("scope", idOrNull(_node.scope()))
 	});
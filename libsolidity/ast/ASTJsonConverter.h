@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <ostream>
 #include <stack>
 #include <libsolidity/ast/ASTVisitor.h>
@@ -31,6 +32,10 @@
 
 namespace dev
 {
+
+class JsonStreamWriter;
+class JsonTreeWriter;
+
 namespace solidity
 {
 
@@ -50,6 +55,12 @@ public:
 	/// Output the json representation of the AST to _stream.
 	void print(std::ostream& _stream, ASTNode const& _node);
 	Json::Value&& toJson(ASTNode const& _node);
+	/// Writes the json representation of the AST using @a _writer. Unless the legacy format
+	/// is used, which arranges nodes depending on their children, each node is written as soon
+	/// as it is converted, without building the whole tree in memory. The output is identical
+	/// to the compact print of toJson(_node).
+	void write(JsonStreamWriter& _writer, ASTNode const& _node);
+	void write(JsonTreeWriter& _writer, ASTNode const& _node);
 	template <class T>
 	Json::Value toJson(std::vector<ASTPointer<T>> const& _nodes)
 	{
@@ -141,15 +152,22 @@ private:
 	{
 		return _node.id();
 	}
+	/// @returns the IDs of the nodes in @a _container, sorted if @a _order is true.
+	/// Sorting is needed for containers ordered by pointer, whose order depends on allocation.
 	template<class Container>
-	static Json::Value getContainerIds(Container const& container)
+	static Json::Value getContainerIds(Container const& _container, bool _order = false)
 	{
-		Json::Value tmp(Json::arrayValue);
-		for (auto const& element: container)
+		std::vector<int> ids;
+		for (auto const& element: _container)
 		{
 			solAssert(element, "");
-			tmp.append(nodeId(*element));
+			ids.push_back(nodeId(*element));
 		}
+		if (_order)
+			std::sort(ids.begin(), ids.end());
+		Json::Value tmp(Json::arrayValue);
+		for (int id: ids)
+			tmp.append(id);
 		return tmp;
 	}
 	static Json::Value typePointerToJson(TypePointer _tp, bool _short = false);
@@ -164,7 +182,23 @@ private:
 		_array.append(std::move(_value));
 	}
 
+	/// A node whose conversion is deferred until it is written, and the context to convert it in.
+	struct Placeholder
+	{
+		ASTNode const* node;
+		bool inEvent;
+	};
+
+	/// @returns a placeholder for @a _node, which writeValue replaces by the node.
+	Json::Value placeholder(ASTNode const& _node);
+	/// Writes @a _value to m_writer, converting the nodes of placeholders.
+	void writeValue(Json::Value const& _value);
+
 	bool m_legacy = false; ///< if true, use legacy format
+	/// If set, nodes are written here once converted, and their children are placeholders.
+	JsonStreamWriter* m_writer = nullptr;
+	/// The placeholders created while writing, referred to by their index.
+	std::vector<Placeholder> m_placeholders;
 	bool m_inEvent = false; ///< whether we are currently inside an event or not
 	Json::Value m_currentValue;
 	std::map<std::string, unsigned> m_sourceIndices;
@@ -125,6 +125,12 @@ bool fitsPrecisionBase2(bigint const& _mantissa, uint32_t _expBase2)
 
 }
 
+recursive_mutex& dev::solidity::lazyCacheMutex()
+{
+	static recursive_mutex mutex;
+	return mutex;
+}
+
 void StorageOffsets::computeOffsets(TypePointers const& _types)
 {
 	bigint slotOffset = 0;
@@ -185,6 +191,7 @@ void MemberList::combine(MemberList const & _other)
 
 pair<u256, unsigned> const* MemberList::memberStorageOffset(string const& _name) const
 {
+	lock_guard<recursive_mutex> lock(lazyCacheMutex());
 	if (!m_storageOffsets)
 	{
 		TypePointers memberTypes;
@@ -380,6 +387,7 @@ TypePointer Type::commonType(TypePointer const& _a, TypePointer const& _b)
 
 MemberList const& Type::members(ContractDefinition const* _currentScope) const
 {
+	lock_guard<recursive_mutex> lock(lazyCacheMutex());
 	if (!m_members[_currentScope])
 	{
 		MemberList::MemberMap members = nativeMembers(_currentScope);
@@ -1898,6 +1906,7 @@ void ContractType::addNonConflictingAddressMembers(MemberList::MemberMap& _membe
 
 shared_ptr<FunctionType const> const& ContractType::newExpressionType() const
 {
+	lock_guard<recursive_mutex> lock(lazyCacheMutex());
 	if (!m_constructorType)
 		m_constructorType = FunctionType::newExpressionType(m_contract);
 	return m_constructorType;
@@ -2138,6 +2147,7 @@ set<string> StructType::membersMissingInMemory() const
 
 bool StructType::recursive() const
 {
+	lock_guard<recursive_mutex> lock(lazyCacheMutex());
 	if (!m_recursive.is_initialized())
 	{
 		auto visitor = [&](StructDefinition const& _struct, CycleDetector<StructDefinition>& _cycleDetector)
@@ -2868,6 +2878,22 @@ bool FunctionType::isBareCall() const
 string FunctionType::externalSignature() const
 {
 	solAssert(m_declaration != nullptr, "External signature of function needs declaration");
+	return m_declaration->cachedExternalSignature([&]() { return buildExternalSignature(); });
+}
+
+h256 FunctionType::externalSignatureHash() const
+{
+	solAssert(m_declaration != nullptr, "External signature of function needs declaration");
+	return m_declaration->cachedExternalSignatureHash([&]() { return buildExternalSignature(); });
+}
+
+u256 FunctionType::externalIdentifier() const
+{
+	return FixedHash<4>::Arith(FixedHash<4>(externalSignatureHash()));
+}
+
+string FunctionType::buildExternalSignature() const
+{
 	solAssert(!m_declaration->name().empty(), "Fallback function has no signature.");
 
 	bool const inLibrary = dynamic_cast<ContractDefinition const&>(*m_declaration->scope()).isLibrary();
@@ -2885,11 +2911,6 @@ string FunctionType::externalSignature() const
 	return m_declaration->name() + "(" + boost::algorithm::join(typeStrings, ",") + ")";
 }
 
-u256 FunctionType::externalIdentifier() const
-{
-	return FixedHash<4>::Arith(FixedHash<4>(dev::keccak256(externalSignature())));
-}
-
 bool FunctionType::isPure() const
 {
 	// FIXME: replace this with m_stateMutability == StateMutability::Pure once
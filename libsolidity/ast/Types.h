@@ -29,12 +29,14 @@
 
 #include <libdevcore/Common.h>
 #include <libdevcore/CommonIO.h>
+#include <libdevcore/FixedHash.h>
 
 #include <boost/noncopyable.hpp>
 #include <boost/rational.hpp>
 #include <boost/optional.hpp>
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <map>
 #include <set>
@@ -51,6 +53,11 @@ using FunctionTypePointer = std::shared_ptr<FunctionType const>;
 using TypePointers = std::vector<TypePointer>;
 using rational = boost::rational<dev::bigint>;
 
+/// @returns the mutex that guards the lazily computed caches of types and AST nodes
+/// (member lists, storage offsets, interface function lists, ...), which are shared
+/// between analysis passes running concurrently on different contracts.
+std::recursive_mutex& lazyCacheMutex();
+
 
 enum class DataLocation { Storage, CallData, Memory };
 
@@ -1039,7 +1046,10 @@ public:
 	Kind const& kind() const { return m_kind; }
 	StateMutability stateMutability() const { return m_stateMutability; }
 	/// @returns the external signature of this function type given the function name
+	/// The signature and its hash are cached at the declaration.
 	std::string externalSignature() const;
+	/// @returns the Keccak-256 hash of the external signature, i.e. the topic of an event.
+	h256 externalSignatureHash() const;
 	/// @returns the external identifier of this function (the hash of the signature).
 	u256 externalIdentifier() const;
 	Declaration const& declaration() const
@@ -1095,6 +1105,8 @@ public:
 
 private:
 	static TypePointers parseElementaryTypeVector(strings const& _types);
+	/// @returns the external signature without consulting the cache of the declaration.
+	std::string buildExternalSignature() const;
 
 	TypePointers m_parameterTypes;
 	TypePointers m_returnParameterTypes;
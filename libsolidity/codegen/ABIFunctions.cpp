@@ -34,6 +34,14 @@ using namespace std;
 using namespace dev;
 using namespace dev::solidity;
 
+ABIFunctions::ABIFunctions(EVMVersion _evmVersion, shared_ptr<ABIFunctionsCache> _cache):
+	m_evmVersion(_evmVersion),
+	m_cache(move(_cache))
+{
+	if (m_cache)
+		solAssert(m_cache->evmVersion == m_evmVersion, "ABI functions cache used with different EVM version.");
+}
+
 string ABIFunctions::tupleEncoder(
 	TypePointers const& _givenTypes,
 	TypePointers const& _targetTypes,
@@ -1183,12 +1191,15 @@ string ABIFunctions::abiDecodingFunctionArray(ArrayType const& _type, bool _from
 
 string ABIFunctions::abiDecodingFunctionCalldataArray(ArrayType const& _type)
 {
-	// This does not work with arrays of complex types - the array access
-	// is not yet implemented in Solidity.
+	// Elements of dynamically-sized array type are only checked once they are
+	// accessed, other complex types are not yet supported in calldata.
 	solAssert(_type.dataStoredIn(DataLocation::CallData), "");
 	if (!_type.isDynamicallySized())
 		solAssert(_type.length() < u256("0xffffffffffffffff"), "");
-	solAssert(!_type.baseType()->isDynamicallyEncoded(), "");
+	solUnimplementedAssert(
+		!_type.baseType()->isDynamicallyEncoded() || _type.baseType()->isDynamicallySized(),
+		"Calldata arrays with statically-sized dynamically encoded elements not yet implemented."
+	);
 	solAssert(_type.baseType()->calldataEncodedSize() < u256("0xffffffffffffffff"), "");
 
 	string functionName =
@@ -1673,15 +1684,38 @@ string ABIFunctions::allocationFunction()
 
 string ABIFunctions::createFunction(string const& _name, function<string ()> const& _creator)
 {
+	if (!m_dependencyStack.empty())
+		m_dependencyStack.back()->push_back(_name);
 	if (!m_requestedFunctions.count(_name))
 	{
-		auto fun = _creator();
-		solAssert(!fun.empty(), "");
-		m_requestedFunctions[_name] = fun;
+		if (m_cache && m_cache->functions.count(_name))
+			requestCachedFunction(_name);
+		else
+		{
+			vector<string> dependencies;
+			m_dependencyStack.push_back(&dependencies);
+			ScopeGuard popDependencies([&]() { m_dependencyStack.pop_back(); });
+			auto fun = _creator();
+			solAssert(!fun.empty(), "");
+			m_requestedFunctions[_name] = fun;
+			if (m_cache)
+				m_cache->functions[_name] = ABIFunctionsCache::Function{move(fun), move(dependencies)};
+		}
 	}
 	return _name;
 }
 
+void ABIFunctions::requestCachedFunction(string const& _name)
+{
+	if (m_requestedFunctions.count(_name))
+		return;
+	solAssert(m_cache && m_cache->functions.count(_name), "Function " + _name + " not found in cache.");
+	ABIFunctionsCache::Function const& function = m_cache->functions.at(_name);
+	m_requestedFunctions[_name] = function.code;
+	for (auto const& dependency: function.dependencies)
+		requestCachedFunction(dependency);
+}
+
 size_t ABIFunctions::headSize(TypePointers const& _targetTypes)
 {
 	size_t headSize = 0;
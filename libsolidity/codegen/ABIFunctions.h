@@ -25,10 +25,12 @@
 #include <libsolidity/interface/EVMVersion.h>
 
 #include <libsolidity/ast/ASTForward.h>
+#include <libsolidity/inlineasm/AsmDataForward.h>
 
 #include <vector>
 #include <functional>
 #include <map>
+#include <memory>
 
 namespace dev {
 namespace solidity {
@@ -40,6 +42,43 @@ class FunctionType;
 using TypePointer = std::shared_ptr<Type const>;
 using TypePointers = std::vector<TypePointer>;
 
+namespace assembly
+{
+struct AsmAnalysisInfo;
+}
+
+///
+/// Routines generated by ABIFunctions, shared between the contracts of a compilation.
+/// The code of a routine only depends on its name (which encodes the involved types)
+/// and the EVM version, so each routine only has to be generated once. The cache also
+/// stores the parsed and analysed inline assembly blocks the routines are compiled from,
+/// since contracts often request the very same set of routines.
+///
+/// The cache must not outlive the AST the type identifiers refer to and is not thread-safe.
+struct ABIFunctionsCache
+{
+	struct Function
+	{
+		std::string code;
+		/// Names of the routines that are called by this routine.
+		std::vector<std::string> dependencies;
+	};
+	struct AnalysedBlock
+	{
+		std::shared_ptr<assembly::Block> block;
+		std::shared_ptr<assembly::AsmAnalysisInfo> analysisInfo;
+	};
+
+	explicit ABIFunctionsCache(EVMVersion _evmVersion): evmVersion(_evmVersion) {}
+
+	EVMVersion const evmVersion;
+	/// Map from function name to code and dependencies.
+	std::map<std::string, Function> functions;
+	/// Map from the source of an inline assembly block without external references
+	/// to its parsed and analysed form.
+	std::map<std::string, AnalysedBlock> blocks;
+};
+
 ///
 /// Class to generate encoding and decoding functions. Also maintains a collection
 /// of "functions to be generated" in order to avoid generating the same function
@@ -50,7 +89,11 @@ using TypePointers = std::vector<TypePointer>;
 class ABIFunctions
 {
 public:
-	explicit ABIFunctions(EVMVersion _evmVersion = EVMVersion{}) : m_evmVersion(_evmVersion) {}
+	/// @param _cache if given, generated routines are taken from and stored in this cache.
+	explicit ABIFunctions(
+		EVMVersion _evmVersion = EVMVersion{},
+		std::shared_ptr<ABIFunctionsCache> _cache = nullptr
+	);
 
 	/// @returns name of an assembly function to ABI-encode values of @a _givenTypes
 	/// into memory, converting the types to @a _targetTypes on the fly.
@@ -221,8 +264,11 @@ private:
 
 	/// Helper function that uses @a _creator to create a function and add it to
 	/// @a m_requestedFunctions if it has not been created yet and returns @a _name in both
-	/// cases.
+	/// cases. If the function is found in the cache, it is requested together with its
+	/// dependencies without calling @a _creator.
 	std::string createFunction(std::string const& _name, std::function<std::string()> const& _creator);
+	/// Adds the cached function @a _name and (recursively) its dependencies to @a m_requestedFunctions.
+	void requestCachedFunction(std::string const& _name);
 
 	/// @returns the size of the static part of the encoding of the given types.
 	static size_t headSize(TypePointers const& _targetTypes);
@@ -231,6 +277,9 @@ private:
 	std::map<std::string, std::string> m_requestedFunctions;
 
 	EVMVersion m_evmVersion;
+	std::shared_ptr<ABIFunctionsCache> m_cache;
+	/// Dependency lists of the functions currently being created, innermost last.
+	std::vector<std::vector<std::string>*> m_dependencyStack;
 };
 
 }
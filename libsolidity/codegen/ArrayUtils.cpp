@@ -48,6 +48,10 @@ void ArrayUtils::copyArrayToStorage(ArrayType const& _targetType, ArrayType cons
 
 	bool sourceIsStorage = _sourceType.location() == DataLocation::Storage;
 	bool fromCalldata = _sourceType.location() == DataLocation::CallData;
+	solUnimplementedAssert(
+		!fromCalldata || !sourceBaseType->isDynamicallyEncoded(),
+		"Copying nested calldata arrays to storage is not yet implemented."
+	);
 	bool directCopy = sourceIsStorage && sourceBaseType->isValueType() && *sourceBaseType == *targetBaseType;
 	bool haveByteOffsetSource = !directCopy && sourceIsStorage && sourceBaseType->storageBytes() <= 16;
 	bool haveByteOffsetTarget = !directCopy && targetBaseType->storageBytes() <= 16;
@@ -1108,6 +1112,52 @@ void ArrayUtils::accessIndex(ArrayType const& _arrayType, bool _doBoundsCheck) c
 	}
 }
 
+void ArrayUtils::accessCallDataArrayElement(ArrayType const& _arrayType, bool _doBoundsCheck) const
+{
+	solAssert(_arrayType.location() == DataLocation::CallData, "");
+	if (_arrayType.baseType()->isDynamicallyEncoded())
+	{
+		solUnimplementedAssert(
+			_arrayType.baseType()->isDynamicallySized(),
+			"Access to statically-sized dynamically encoded calldata array elements not yet implemented."
+		);
+		auto const& baseType = dynamic_cast<ArrayType const&>(*_arrayType.baseType());
+		// The offsets in the head are relative to the start of the array, so keep a copy of it.
+		// stack: <base_ref> [<length>] <index>
+		if (_arrayType.isDynamicallySized())
+			m_context << Instruction::DUP3 << Instruction::SWAP2 << Instruction::SWAP1;
+		else
+			m_context << Instruction::DUP2 << Instruction::SWAP1;
+		// stack: <base_ref> <base_ref> [<length>] <index>
+		accessIndex(_arrayType, _doBoundsCheck);
+		// stack: <base_ref> <head_ref>
+		m_context.appendInlineAssembly(R"({
+			let rel_offset := calldataload(head_ref)
+			if gt(rel_offset, 0xffffffffffffffff) { revert(0, 0) }
+			ref := add(ref, rel_offset)
+			// Replace head_ref by the length of the element
+			head_ref := calldataload(ref)
+			ref := add(ref, 0x20)
+			if or(
+				gt(head_ref, 0xffffffffffffffff),
+				gt(add(ref, mul(head_ref, )" + to_string(baseType.isByteArray() ? 1 : baseType.baseType()->calldataEncodedSize()) + R"()), calldatasize())
+			) { revert(0, 0) }
+		})", {"ref", "head_ref"});
+		// stack: <element_data_ref> <element_length>
+	}
+	else
+	{
+		accessIndex(_arrayType, _doBoundsCheck);
+		if (_arrayType.baseType()->isValueType())
+			CompilerUtils(m_context).loadFromMemoryDynamic(
+				*_arrayType.baseType(),
+				true,
+				!_arrayType.isByteArray(),
+				false
+			);
+	}
+}
+
 void ArrayUtils::incrementByteOffset(unsigned _byteSize, unsigned _byteOffsetPosition, unsigned _storageOffsetPosition) const
 {
 	solAssert(_byteSize < 32, "");
@@ -102,6 +102,14 @@ public:
 	/// Stack post (storage): storage_slot byte_offset
 	/// Stack post: memory/calldata_offset
 	void accessIndex(ArrayType const& _arrayType, bool _doBoundsCheck = true) const;
+	/// Performs bounds checking and accesses an element of an array in calldata without
+	/// copying it to memory. Elements of dynamically-sized array type are resolved through
+	/// the offset stored in the head of the array and their length is validated against
+	/// the size of the calldata.
+	/// Stack pre: reference [length] index
+	/// Stack post (value type elements): value
+	/// Stack post: calldata_offset [length]
+	void accessCallDataArrayElement(ArrayType const& _arrayType, bool _doBoundsCheck = true) const;
 
 private:
 	/// Adds the given number of bytes to a storage byte offset counter and also increments
@@ -36,13 +36,25 @@ namespace solidity {
 class Compiler
 {
 public:
-	explicit Compiler(EVMVersion _evmVersion = EVMVersion{}, bool _optimize = false, unsigned _runs = 200):
+	/// @param _abiFunctionsCache optional cache to share generated ABI routines with
+	/// the other contracts of the compilation.
+	explicit Compiler(
+		EVMVersion _evmVersion = EVMVersion{},
+		bool _optimize = false,
+		unsigned _runs = 200,
+		std::shared_ptr<ABIFunctionsCache> _abiFunctionsCache = nullptr
+	):
 		m_optimize(_optimize),
 		m_optimizeRuns(_runs),
-		m_runtimeContext(_evmVersion),
-		m_context(_evmVersion, &m_runtimeContext)
+		m_runtimeContext(_evmVersion, nullptr, _abiFunctionsCache),
+		m_context(_evmVersion, &m_runtimeContext, _abiFunctionsCache)
 	{ }
 
+	/// Enables releasing the memory allocated by a statement at the end of the statement
+	/// if it cannot be referenced afterwards. This needs an additional stack slot during
+	/// such statements.
+	void setReleaseStatementMemory(bool _release) { m_releaseStatementMemory = _release; }
+
 	/// Compiles a contract.
 	/// @arg _metadata contains the to be injected metadata CBOR
 	void compileContract(
@@ -84,6 +96,7 @@ public:
 private:
 	bool const m_optimize;
 	unsigned const m_optimizeRuns;
+	bool m_releaseStatementMemory = false;
 	CompilerContext m_runtimeContext;
 	size_t m_runtimeSub = size_t(-1); ///< Identifier of the runtime sub-assembly, if present.
 	CompilerContext m_context;
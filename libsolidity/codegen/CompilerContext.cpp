@@ -332,44 +332,60 @@ void CompilerContext::appendInlineAssembly(
 		}
 	};
 
-	ErrorList errors;
-	ErrorReporter errorReporter(errors);
-	auto scanner = make_shared<Scanner>(CharStream(_assembly), "--CODEGEN--");
-	auto parserResult = assembly::Parser(errorReporter, assembly::AsmFlavour::Strict).parse(scanner, false);
+	// Blocks that do not refer to local variables do not depend on the context,
+	// so their parsed and analysed form can be shared between contracts.
+	bool cacheable = m_abiFunctionsCache && _localVariables.empty();
+	shared_ptr<assembly::Block> parserResult;
+	shared_ptr<assembly::AsmAnalysisInfo> analysisInfo;
+	if (cacheable && m_abiFunctionsCache->blocks.count(_assembly))
+	{
+		ABIFunctionsCache::AnalysedBlock const& cached = m_abiFunctionsCache->blocks.at(_assembly);
+		parserResult = cached.block;
+		analysisInfo = cached.analysisInfo;
+	}
+	else
+	{
+		ErrorList errors;
+		ErrorReporter errorReporter(errors);
+		auto scanner = make_shared<Scanner>(CharStream(_assembly), "--CODEGEN--");
+		parserResult = assembly::Parser(errorReporter, assembly::AsmFlavour::Strict).parse(scanner, false);
 #ifdef SOL_OUTPUT_ASM
-	cout << assembly::AsmPrinter()(*parserResult) << endl;
+		cout << assembly::AsmPrinter()(*parserResult) << endl;
 #endif
-	assembly::AsmAnalysisInfo analysisInfo;
-	bool analyzerResult = false;
-	if (parserResult)
-		analyzerResult = assembly::AsmAnalyzer(
-			analysisInfo,
-			errorReporter,
-			m_evmVersion,
-			boost::none,
-			assembly::AsmFlavour::Strict,
-			identifierAccess.resolve
-		).analyze(*parserResult);
-	if (!parserResult || !errorReporter.errors().empty() || !analyzerResult)
-	{
-		string message =
-			"Error parsing/analyzing inline assembly block:\n"
-			"------------------ Input: -----------------\n" +
-			_assembly + "\n"
-			"------------------ Errors: ----------------\n";
-		for (auto const& error: errorReporter.errors())
-			message += SourceReferenceFormatter::formatExceptionInformation(
-				*error,
-				(error->type() == Error::Type::Warning) ? "Warning" : "Error",
-				[&](string const&) -> Scanner const& { return *scanner; }
-			);
-		message += "-------------------------------------------\n";
+		analysisInfo = make_shared<assembly::AsmAnalysisInfo>();
+		bool analyzerResult = false;
+		if (parserResult)
+			analyzerResult = assembly::AsmAnalyzer(
+				*analysisInfo,
+				errorReporter,
+				m_evmVersion,
+				boost::none,
+				assembly::AsmFlavour::Strict,
+				identifierAccess.resolve
+			).analyze(*parserResult);
+		if (!parserResult || !errorReporter.errors().empty() || !analyzerResult)
+		{
+			string message =
+				"Error parsing/analyzing inline assembly block:\n"
+				"------------------ Input: -----------------\n" +
+				_assembly + "\n"
+				"------------------ Errors: ----------------\n";
+			for (auto const& error: errorReporter.errors())
+				message += SourceReferenceFormatter::formatExceptionInformation(
+					*error,
+					(error->type() == Error::Type::Warning) ? "Warning" : "Error",
+					[&](string const&) -> Scanner const& { return *scanner; }
+				);
+			message += "-------------------------------------------\n";
+
+			solAssert(false, message);
+		}
 
-		solAssert(false, message);
+		solAssert(errorReporter.errors().empty(), "Failed to analyze inline assembly block.");
+		if (cacheable)
+			m_abiFunctionsCache->blocks[_assembly] = ABIFunctionsCache::AnalysedBlock{parserResult, analysisInfo};
 	}
-
-	solAssert(errorReporter.errors().empty(), "Failed to analyze inline assembly block.");
-	assembly::CodeGenerator::assemble(*parserResult, analysisInfo, *m_asm, identifierAccess, _system);
+	assembly::CodeGenerator::assemble(*parserResult, *analysisInfo, *m_asm, identifierAccess, _system);
 
 	// Reset the source location to the one of the node (instead of the CODEGEN source location)
 	updateSourceLocation();
@@ -52,17 +52,25 @@ namespace solidity {
 class CompilerContext
 {
 public:
-	explicit CompilerContext(EVMVersion _evmVersion = EVMVersion{}, CompilerContext* _runtimeContext = nullptr):
+	/// @param _abiFunctionsCache if given, generated ABI routines and inline assembly blocks
+	/// without references to local variables are shared through this cache.
+	explicit CompilerContext(
+		EVMVersion _evmVersion = EVMVersion{},
+		CompilerContext* _runtimeContext = nullptr,
+		std::shared_ptr<ABIFunctionsCache> _abiFunctionsCache = nullptr
+	):
 		m_asm(std::make_shared<eth::Assembly>()),
 		m_evmVersion(_evmVersion),
 		m_runtimeContext(_runtimeContext),
-		m_abiFunctions(m_evmVersion)
+		m_abiFunctionsCache(_abiFunctionsCache),
+		m_abiFunctions(m_evmVersion, _abiFunctionsCache)
 	{
 		if (m_runtimeContext)
 			m_runtimeSub = size_t(m_asm->newSub(m_runtimeContext->m_asm).data());
 	}
 
 	EVMVersion const& evmVersion() const { return m_evmVersion; }
+	std::shared_ptr<ABIFunctionsCache> const& abiFunctionsCache() const { return m_abiFunctionsCache; }
 
 	/// Update currently enabled set of experimental features.
 	void setExperimentalFeatures(std::set<ExperimentalFeature> const& _features) { m_experimentalFeatures = _features; }
@@ -319,6 +327,8 @@ private:
 	size_t m_runtimeSub = -1;
 	/// An index of low-level function labels by name.
 	std::map<std::string, eth::AssemblyItem> m_lowLevelFunctions;
+	/// Cache shared between the contracts of a compilation, might be null.
+	std::shared_ptr<ABIFunctionsCache> m_abiFunctionsCache;
 	/// Container for ABI functions to be generated.
 	ABIFunctions m_abiFunctions;
 	/// The queue of low-level functions to generate.
@@ -877,7 +877,10 @@ void CompilerUtils::convertType(
 					auto loopEnd = m_context.appendConditionalJump();
 					copyToStackTop(3 + stackSize, stackSize);
 					copyToStackTop(2 + stackSize, 1);
-					ArrayUtils(m_context).accessIndex(typeOnStack, false);
+					if (typeOnStack.location() == DataLocation::CallData)
+						ArrayUtils(m_context).accessCallDataArrayElement(typeOnStack, false);
+					else
+						ArrayUtils(m_context).accessIndex(typeOnStack, false);
 					if (typeOnStack.location() == DataLocation::Storage)
 						StorageItem(m_context, *typeOnStack.baseType()).retrieveValue(SourceLocation(), true);
 					convertType(*typeOnStack.baseType(), *targetType.baseType(), _cleanupNeeded);
@@ -26,6 +26,8 @@
 #include <libsolidity/interface/ErrorReporter.h>
 #include <libsolidity/codegen/ExpressionCompiler.h>
 #include <libsolidity/codegen/CompilerUtils.h>
+#include <libsolidity/codegen/MemoryEscapeAnalyzer.h>
+#include <libsolidity/codegen/StackSlotAllocator.h>
 
 #include <libevmasm/Instruction.h>
 #include <libevmasm/Assembly.h>
@@ -56,6 +58,57 @@ private:
 	unsigned stackHeight;
 };
 
+/**
+ * Collects the local variables a statement accesses and an upper bound of the number
+ * of stack slots its expressions occupy on top of them, which is the total size of the
+ * values of all expressions plus the return label, value and gas of each function call.
+ */
+class StackUsageEstimator: private ASTConstVisitor
+{
+public:
+	StackUsageEstimator(CompilerContext const& _context, Statement const& _statement): m_context(_context)
+	{
+		_statement.accept(*this);
+	}
+
+	std::vector<Declaration const*> const& variables() const { return m_variables; }
+	unsigned temporaries() const { return m_temporaries; }
+
+private:
+	bool visit(VariableDeclaration const& _variable) override
+	{
+		addVariable(&_variable);
+		return true;
+	}
+	bool visit(Identifier const& _identifier) override
+	{
+		addVariable(_identifier.annotation().referencedDeclaration);
+		return visitNode(_identifier);
+	}
+	bool visit(FunctionCall const& _functionCall) override
+	{
+		m_temporaries += 3;
+		return visitNode(_functionCall);
+	}
+	bool visitNode(ASTNode const& _node) override
+	{
+		if (auto expression = dynamic_cast<Expression const*>(&_node))
+			if (TypePointer const& type = expression->annotation().type)
+				m_temporaries += type->sizeOnStack();
+		return true;
+	}
+
+	void addVariable(Declaration const* _declaration)
+	{
+		if (_declaration && m_context.isLocalVariable(_declaration))
+			m_variables.push_back(_declaration);
+	}
+
+	CompilerContext const& m_context;
+	std::vector<Declaration const*> m_variables;
+	unsigned m_temporaries = 0;
+};
+
 }
 
 void ContractCompiler::compileContract(
@@ -441,12 +494,26 @@ bool ContractCompiler::visit(FunctionDefinition const& _function)
 
 	for (ASTPointer<VariableDeclaration const> const& variable: _function.returnParameters())
 		appendStackVariableInitialisation(*variable);
-	for (VariableDeclaration const* localVariable: _function.localVariables())
+
+	vector<ModifierDefinition const*> modifiers;
+	for (ASTPointer<ModifierInvocation> const& modifier: _function.modifiers())
+		if (auto modifierDefinition = dynamic_cast<ModifierDefinition const*>(modifier->name()->annotation().referencedDeclaration))
+			modifiers.push_back(&m_context.resolveVirtualFunctionModifier(*modifierDefinition));
+	auto stackSlots = make_shared<StackSlotAllocator>(_function, modifiers, m_optimise);
+	for (VariableDeclaration const* localVariable: stackSlots->slotOwners())
 		appendStackVariableInitialisation(*localVariable);
+	for (VariableDeclaration const* localVariable: _function.localVariables())
+	{
+		VariableDeclaration const& owner = stackSlots->slotOwner(*localVariable);
+		if (&owner != localVariable)
+			m_context.addVariable(*localVariable, m_context.stackHeight() - m_context.baseStackOffsetOfVariable(owner));
+	}
 
 	if (_function.isConstructor())
 		if (auto c = m_context.nextConstructor(dynamic_cast<ContractDefinition const&>(*_function.scope())))
 			appendBaseConstructor(*c);
+	// Base constructors are compiled with their own allocation.
+	m_stackSlots = stackSlots;
 
 	solAssert(m_returnTags.empty(), "");
 	m_breakTags.clear();
@@ -467,7 +534,7 @@ bool ContractCompiler::visit(FunctionDefinition const& _function)
 
 	unsigned const c_argumentsSize = CompilerUtils::sizeOnStack(_function.parameters());
 	unsigned const c_returnValuesSize = CompilerUtils::sizeOnStack(_function.returnParameters());
-	unsigned const c_localVariablesSize = CompilerUtils::sizeOnStack(_function.localVariables());
+	unsigned const c_localVariablesSize = CompilerUtils::sizeOnStack(stackSlots->slotOwners());
 
 	vector<int> stackLayout;
 	stackLayout.push_back(c_returnValuesSize); // target of return address
@@ -641,6 +708,24 @@ bool ContractCompiler::visit(InlineAssembly const& _inlineAssembly)
 	return false;
 }
 
+bool ContractCompiler::visit(Block const& _block)
+{
+	for (ASTPointer<Statement> const& statement: _block.statements())
+	{
+		if (m_stackSlots)
+			for (VariableDeclaration const* variable: m_stackSlots->variablesToReset(*statement))
+			{
+				// The slot was used by another variable before.
+				CompilerContext::LocationSetter locationSetter(m_context, *variable);
+				CompilerUtils utils(m_context);
+				utils.pushZeroValue(*variable->annotation().type);
+				utils.moveToStackVariable(*variable);
+			}
+		statement->accept(*this);
+	}
+	return false;
+}
+
 bool ContractCompiler::visit(IfStatement const& _ifStatement)
 {
 	StackHeightChecker checker(m_context);
@@ -803,7 +888,9 @@ bool ContractCompiler::visit(EmitStatement const& _emit)
 {
 	CompilerContext::LocationSetter locationSetter(m_context, _emit);
 	StackHeightChecker checker(m_context);
+	bool savedFreeMemoryPointer = saveFreeMemoryPointer(_emit);
 	compileExpression(_emit.eventCall());
+	restoreFreeMemoryPointer(savedFreeMemoryPointer);
 	checker.check();
 	return false;
 }
@@ -814,6 +901,7 @@ bool ContractCompiler::visit(VariableDeclarationStatement const& _variableDeclar
 	CompilerContext::LocationSetter locationSetter(m_context, _variableDeclarationStatement);
 	if (Expression const* expression = _variableDeclarationStatement.initialValue())
 	{
+		bool savedFreeMemoryPointer = saveFreeMemoryPointer(_variableDeclarationStatement);
 		CompilerUtils utils(m_context);
 		compileExpression(*expression);
 		TypePointers valueTypes;
@@ -836,6 +924,7 @@ bool ContractCompiler::visit(VariableDeclarationStatement const& _variableDeclar
 				utils.moveToStackVariable(*varDecl);
 			}
 		}
+		restoreFreeMemoryPointer(savedFreeMemoryPointer);
 	}
 	checker.check();
 	return false;
@@ -846,8 +935,10 @@ bool ContractCompiler::visit(ExpressionStatement const& _expressionStatement)
 	StackHeightChecker checker(m_context);
 	CompilerContext::LocationSetter locationSetter(m_context, _expressionStatement);
 	Expression const& expression = _expressionStatement.expression();
+	bool savedFreeMemoryPointer = saveFreeMemoryPointer(_expressionStatement);
 	compileExpression(expression);
 	CompilerUtils(m_context).popStackElement(*expression.annotation().type);
+	restoreFreeMemoryPointer(savedFreeMemoryPointer);
 	checker.check();
 	return false;
 }
@@ -961,6 +1052,29 @@ void ContractCompiler::compileExpression(Expression const& _expression, TypePoin
 		CompilerUtils(m_context).convertType(*_expression.annotation().type, *_targetType);
 }
 
+bool ContractCompiler::saveFreeMemoryPointer(Statement const& _statement)
+{
+	if (!m_releaseStatementMemory || !MemoryEscapeAnalyzer::canReleaseMemory(_statement))
+		return false;
+	// The saved pointer moves all local variables one slot further away from the top of the
+	// stack, so do not save it if this could make a variable the statement accesses unreachable.
+	StackUsageEstimator estimator(m_context, _statement);
+	for (Declaration const* variable: estimator.variables())
+	{
+		unsigned depth = m_context.baseToCurrentStackOffset(m_context.baseStackOffsetOfVariable(*variable)) + 1;
+		if (depth + 1 + estimator.temporaries() > 16)
+			return false;
+	}
+	CompilerUtils(m_context).fetchFreeMemoryPointer();
+	return true;
+}
+
+void ContractCompiler::restoreFreeMemoryPointer(bool _saved)
+{
+	if (_saved)
+		CompilerUtils(m_context).storeFreeMemoryPointer();
+}
+
 eth::AssemblyPointer ContractCompiler::cloneRuntime() const
 {
 	eth::Assembly a;
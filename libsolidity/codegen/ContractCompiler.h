@@ -31,6 +31,8 @@
 namespace dev {
 namespace solidity {
 
+class StackSlotAllocator;
+
 /**
  * Code generator at the contract level. Can be used to generate code for exactly one contract
  * either either in "runtime mode" or "creation mode".
@@ -38,12 +40,24 @@ namespace solidity {
 class ContractCompiler: private ASTConstVisitor
 {
 public:
-	explicit ContractCompiler(ContractCompiler* _runtimeCompiler, CompilerContext& _context, bool _optimise):
+	/// @param _releaseStatementMemory if true, memory allocated by a statement is released at the
+	/// end of the statement if it cannot be referenced afterwards.
+	explicit ContractCompiler(
+		ContractCompiler* _runtimeCompiler,
+		CompilerContext& _context,
+		bool _optimise,
+		bool _releaseStatementMemory = false
+	):
 		m_optimise(_optimise),
+		m_releaseStatementMemory(_releaseStatementMemory),
 		m_runtimeCompiler(_runtimeCompiler),
 		m_context(_context)
 	{
-		m_context = CompilerContext(_context.evmVersion(), _runtimeCompiler ? &_runtimeCompiler->m_context : nullptr);
+		m_context = CompilerContext(
+			_context.evmVersion(),
+			_runtimeCompiler ? &_runtimeCompiler->m_context : nullptr,
+			_context.abiFunctionsCache()
+		);
 	}
 
 	void compileContract(
@@ -98,6 +112,7 @@ private:
 	virtual bool visit(VariableDeclaration const& _variableDeclaration) override;
 	virtual bool visit(FunctionDefinition const& _function) override;
 	virtual bool visit(InlineAssembly const& _inlineAssembly) override;
+	virtual bool visit(Block const& _block) override;
 	virtual bool visit(IfStatement const& _ifStatement) override;
 	virtual bool visit(WhileStatement const& _whileStatement) override;
 	virtual bool visit(ForStatement const& _forStatement) override;
@@ -119,11 +134,17 @@ private:
 
 	void appendStackVariableInitialisation(VariableDeclaration const& _variable);
 	void compileExpression(Expression const& _expression, TypePointer const& _targetType = TypePointer());
+	/// Pushes the free memory pointer if the memory allocated by @a _statement can be released
+	/// after it. @returns true if it did.
+	bool saveFreeMemoryPointer(Statement const& _statement);
+	/// Restores the free memory pointer pushed by saveFreeMemoryPointer if @a _saved is true.
+	void restoreFreeMemoryPointer(bool _saved);
 
 	/// @returns the runtime assembly for clone contracts.
 	eth::AssemblyPointer cloneRuntime() const;
 
 	bool const m_optimise;
+	bool const m_releaseStatementMemory;
 	/// Pointer to the runtime compiler in case this is a creation compiler.
 	ContractCompiler* m_runtimeCompiler = nullptr;
 	CompilerContext& m_context;
@@ -133,6 +154,8 @@ private:
 	std::vector<eth::AssemblyItem> m_returnTags;
 	unsigned m_modifierDepth = 0;
 	FunctionDefinition const* m_currentFunction = nullptr;
+	/// Stack slots of the local variables of the current function.
+	std::shared_ptr<StackSlotAllocator> m_stackSlots;
 	unsigned m_stackCleanupForReturn = 0; ///< this number of stack elements need to be removed before jump to m_returnTag
 	// arguments for base constructors, filled in derived-to-base order
 	std::map<FunctionDefinition const*, ASTNode const*> const* m_baseArguments;
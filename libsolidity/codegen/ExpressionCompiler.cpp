@@ -186,6 +186,28 @@ void ExpressionCompiler::appendStateVariableAccessor(VariableDeclaration const&
 	m_context.appendJump(eth::AssemblyItem::JumpType::OutOfFunction);
 }
 
+FunctionCall const* ExpressionCompiler::hashedEncoding(FunctionCall const& _functionCall)
+{
+	auto functionType = dynamic_cast<FunctionType const*>(_functionCall.expression().annotation().type.get());
+	if (
+		_functionCall.annotation().kind != FunctionCallKind::FunctionCall ||
+		!functionType ||
+		functionType->kind() != FunctionType::Kind::SHA3 ||
+		_functionCall.arguments().size() != 1
+	)
+		return nullptr;
+	auto encodeCall = dynamic_cast<FunctionCall const*>(_functionCall.arguments().front().get());
+	if (!encodeCall || encodeCall->annotation().kind != FunctionCallKind::FunctionCall || !encodeCall->names().empty())
+		return nullptr;
+	auto encodeType = dynamic_cast<FunctionType const*>(encodeCall->expression().annotation().type.get());
+	if (
+		!encodeType ||
+		(encodeType->kind() != FunctionType::Kind::ABIEncode && encodeType->kind() != FunctionType::Kind::ABIEncodePacked)
+	)
+		return nullptr;
+	return encodeCall;
+}
+
 bool ExpressionCompiler::visit(Conditional const& _condition)
 {
 	CompilerContext::LocationSetter locationSetter(m_context, _condition);
@@ -699,15 +721,21 @@ bool ExpressionCompiler::visit(FunctionCall const& _functionCall)
 		}
 		case FunctionType::Kind::SHA3:
 		{
+			FunctionCall const* encodeCall = hashedEncoding(_functionCall);
 			TypePointers argumentTypes;
-			for (auto const& arg: arguments)
+			for (auto const& arg: encodeCall ? encodeCall->arguments() : arguments)
 			{
 				arg->accept(*this);
 				argumentTypes.push_back(arg->annotation().type);
 			}
 			utils().fetchFreeMemoryPointer();
 			solAssert(!function.padArguments(), "");
-			utils().packedEncode(argumentTypes, TypePointers());
+			if (encodeCall && dynamic_cast<FunctionType const&>(
+				*encodeCall->expression().annotation().type
+			).kind() == FunctionType::Kind::ABIEncode)
+				utils().abiEncode(argumentTypes, TypePointers());
+			else
+				utils().packedEncode(argumentTypes, TypePointers());
 			utils().toSizeAfterFreeMemoryPointer();
 			m_context << Instruction::KECCAK256;
 			break;
@@ -764,7 +792,7 @@ bool ExpressionCompiler::visit(FunctionCall const& _functionCall)
 				}
 			if (!event.isAnonymous())
 			{
-				m_context << u256(h256::Arith(dev::keccak256(function.externalSignature())));
+				m_context << u256(h256::Arith(function.externalSignatureHash()));
 				++numIndexed;
 			}
 			solAssert(numIndexed <= 4, "Too many indexed arguments.");
@@ -1434,10 +1462,10 @@ bool ExpressionCompiler::visit(IndexAccess const& _indexAccess)
 		_indexAccess.indexExpression()->accept(*this);
 		utils().convertType(*_indexAccess.indexExpression()->annotation().type, IntegerType(256), true);
 		// stack layout: <base_ref> [<length>] <index>
-		ArrayUtils(m_context).accessIndex(arrayType);
 		switch (arrayType.location())
 		{
 		case DataLocation::Storage:
+			ArrayUtils(m_context).accessIndex(arrayType);
 			if (arrayType.isByteArray())
 			{
 				solAssert(!arrayType.isString(), "Index access to string is not allowed.");
@@ -1447,18 +1475,12 @@ bool ExpressionCompiler::visit(IndexAccess const& _indexAccess)
 				setLValueToStorageItem(_indexAccess);
 			break;
 		case DataLocation::Memory:
+			ArrayUtils(m_context).accessIndex(arrayType);
 			setLValue<MemoryItem>(_indexAccess, *_indexAccess.annotation().type, !arrayType.isByteArray());
 			break;
 		case DataLocation::CallData:
-			//@todo if we implement this, the value in calldata has to be added to the base offset
-			solUnimplementedAssert(!arrayType.baseType()->isDynamicallySized(), "Nested arrays not yet implemented.");
-			if (arrayType.baseType()->isValueType())
-				CompilerUtils(m_context).loadFromMemoryDynamic(
-					*arrayType.baseType(),
-					true,
-					!arrayType.isByteArray(),
-					false
-				);
+			// Elements are read from calldata directly, nothing is copied to memory.
+			ArrayUtils(m_context).accessCallDataArrayElement(arrayType);
 			break;
 		}
 	}
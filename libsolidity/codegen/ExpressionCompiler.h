@@ -70,6 +70,11 @@ public:
 	/// Appends code for a Constant State Variable accessor function
 	void appendConstStateVariableAccessor(const VariableDeclaration& _varDecl);
 
+	/// @returns the call to abi.encode or abi.encodePacked if @a _functionCall is a call to
+	/// keccak256 whose only argument is such a call, nullptr otherwise. The encoding is not
+	/// needed after hashing, so its arguments are encoded into unallocated memory directly.
+	static FunctionCall const* hashedEncoding(FunctionCall const& _functionCall);
+
 private:
 	virtual bool visit(Conditional const& _condition) override;
 	virtual bool visit(Assignment const& _assignment) override;
@@ -0,0 +1,125 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Analysis of whether memory allocated by a statement can be used after the statement.
+ */
+
+#include <libsolidity/codegen/MemoryEscapeAnalyzer.h>
+
+#include <libsolidity/codegen/ExpressionCompiler.h>
+#include <libsolidity/ast/AST.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+namespace
+{
+
+bool isMemoryReference(TypePointer const& _type)
+{
+	if (!_type)
+		return false;
+	if (auto tupleType = dynamic_cast<TupleType const*>(_type.get()))
+	{
+		for (auto const& component: tupleType->components())
+			if (isMemoryReference(component))
+				return true;
+		return false;
+	}
+	return _type->dataStoredIn(DataLocation::Memory);
+}
+
+}
+
+bool MemoryEscapeAnalyzer::canReleaseMemory(Statement const& _statement)
+{
+	MemoryEscapeAnalyzer analyzer;
+	_statement.accept(analyzer);
+	return analyzer.m_allocates && !analyzer.m_escapes;
+}
+
+bool MemoryEscapeAnalyzer::visit(VariableDeclarationStatement const& _statement)
+{
+	for (auto const& declaration: _statement.declarations())
+		if (declaration && isMemoryReference(declaration->annotation().type))
+			m_escapes = true;
+	return true;
+}
+
+bool MemoryEscapeAnalyzer::visit(Assignment const& _assignment)
+{
+	if (isMemoryReference(_assignment.leftHandSide().annotation().type))
+		m_escapes = true;
+	return true;
+}
+
+bool MemoryEscapeAnalyzer::visit(UnaryOperation const& _operation)
+{
+	// Deleting a memory reference assigns a newly allocated zero value to it.
+	if (_operation.getOperator() == Token::Delete && isMemoryReference(_operation.subExpression().annotation().type))
+		m_escapes = true;
+	return true;
+}
+
+bool MemoryEscapeAnalyzer::visit(FunctionCall const& _functionCall)
+{
+	if (FunctionCall const* encodeCall = ExpressionCompiler::hashedEncoding(_functionCall))
+	{
+		// The encoding is not allocated, only its arguments have to be inspected.
+		for (auto const& argument: encodeCall->arguments())
+			argument->accept(*this);
+		return false;
+	}
+
+	switch (_functionCall.annotation().kind)
+	{
+	case FunctionCallKind::StructConstructorCall:
+		m_allocates = true;
+		return true;
+	case FunctionCallKind::FunctionCall:
+		break;
+	default:
+		return true;
+	}
+
+	auto const& function = dynamic_cast<FunctionType const&>(*_functionCall.expression().annotation().type);
+	switch (function.kind())
+	{
+	case FunctionType::Kind::Internal:
+		m_escapes = true;
+		break;
+	case FunctionType::Kind::ObjectCreation:
+	case FunctionType::Kind::ABIEncode:
+	case FunctionType::Kind::ABIEncodePacked:
+	case FunctionType::Kind::ABIEncodeWithSelector:
+	case FunctionType::Kind::ABIEncodeWithSignature:
+		m_allocates = true;
+		break;
+	case FunctionType::Kind::External:
+	case FunctionType::Kind::DelegateCall:
+	case FunctionType::Kind::CallCode:
+		// Dynamically-sized return values are decoded into newly allocated memory.
+		for (auto const& returnType: function.returnParameterTypes())
+			if (isMemoryReference(returnType))
+				m_allocates = true;
+		break;
+	default:
+		break;
+	}
+	return true;
+}
@@ -0,0 +1,59 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Analysis of whether memory allocated by a statement can be used after the statement.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTVisitor.h>
+
+namespace dev
+{
+namespace solidity
+{
+
+/**
+ * Determines whether the memory allocated by a simple statement (an expression statement,
+ * an emit statement or a variable declaration statement) can be released at the end of the
+ * statement by resetting the free memory pointer.
+ *
+ * A reference to memory allocated by the statement can only outlive it if it is assigned
+ * to a variable or to a member of a memory object, or if it is handed to an internal
+ * function, which could do the same. Statements that do any of this are rejected.
+ */
+class MemoryEscapeAnalyzer: private ASTConstVisitor
+{
+public:
+	/// @returns true if @a _statement allocates memory and no reference to that memory
+	/// can be used after the statement.
+	static bool canReleaseMemory(Statement const& _statement);
+
+private:
+	virtual bool visit(VariableDeclarationStatement const& _statement) override;
+	virtual bool visit(Assignment const& _assignment) override;
+	virtual bool visit(UnaryOperation const& _operation) override;
+	virtual bool visit(FunctionCall const& _functionCall) override;
+
+	/// Set if the statement allocates memory.
+	bool m_allocates = false;
+	/// Set if a reference to memory might be stored beyond the statement.
+	bool m_escapes = false;
+};
+
+}
+}
@@ -0,0 +1,235 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Assignment of stack slots to the local variables of a function.
+ */
+
+#include <libsolidity/codegen/StackSlotAllocator.h>
+
+#include <libsolidity/ast/AST.h>
+
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+namespace
+{
+
+/// Determines whether the placeholder of a modifier is executed at most once.
+class PlaceholderCounter: private ASTConstVisitor
+{
+public:
+	static bool executedAtMostOnce(ModifierDefinition const& _modifier)
+	{
+		PlaceholderCounter counter;
+		_modifier.body().accept(counter);
+		return counter.m_placeholders <= 1 && !counter.m_placeholderInLoop;
+	}
+
+private:
+	virtual bool visit(WhileStatement const&) override { m_loopDepth++; return true; }
+	virtual void endVisit(WhileStatement const&) override { m_loopDepth--; }
+	virtual bool visit(ForStatement const&) override { m_loopDepth++; return true; }
+	virtual void endVisit(ForStatement const&) override { m_loopDepth--; }
+	virtual bool visit(PlaceholderStatement const&) override
+	{
+		m_placeholders++;
+		if (m_loopDepth > 0)
+			m_placeholderInLoop = true;
+		return true;
+	}
+
+	unsigned m_loopDepth = 0;
+	unsigned m_placeholders = 0;
+	bool m_placeholderInLoop = false;
+};
+
+}
+
+StackSlotAllocator::StackSlotAllocator(
+	FunctionDefinition const& _function,
+	vector<ModifierDefinition const*> const& _modifiers,
+	bool _shareSlots
+)
+{
+	bool bodyExecutedAtMostOnce = all_of(_modifiers.begin(), _modifiers.end(), [](ModifierDefinition const* _modifier) {
+		return PlaceholderCounter::executedAtMostOnce(*_modifier);
+	});
+	if (_shareSlots && bodyExecutedAtMostOnce && _function.isImplemented())
+	{
+		for (VariableDeclaration const* variable: _function.localVariables())
+			m_references[variable];
+		// References in modifier arguments have an empty path, so the variable gets its own slot.
+		for (ASTPointer<ModifierInvocation> const& modifier: _function.modifiers())
+			modifier->accept(*this);
+		_function.body().accept(*this);
+	}
+	allocate(_function);
+}
+
+VariableDeclaration const& StackSlotAllocator::slotOwner(VariableDeclaration const& _variable) const
+{
+	auto it = m_sharedSlots.find(&_variable);
+	return it == m_sharedSlots.end() ? _variable : *it->second;
+}
+
+vector<VariableDeclaration const*> const& StackSlotAllocator::variablesToReset(Statement const& _statement) const
+{
+	static vector<VariableDeclaration const*> const noVariables;
+	auto it = m_variablesToReset.find(&_statement);
+	return it == m_variablesToReset.end() ? noVariables : it->second;
+}
+
+bool StackSlotAllocator::visit(Block const& _block)
+{
+	for (size_t i = 0; i < _block.statements().size(); ++i)
+	{
+		m_path.push_back(PathEntry{&_block, i, m_loopDepth > 0});
+		_block.statements()[i]->accept(*this);
+		m_path.pop_back();
+	}
+	return false;
+}
+
+bool StackSlotAllocator::visit(WhileStatement const&)
+{
+	m_loopDepth++;
+	return true;
+}
+
+void StackSlotAllocator::endVisit(WhileStatement const&)
+{
+	m_loopDepth--;
+}
+
+bool StackSlotAllocator::visit(ForStatement const&)
+{
+	m_loopDepth++;
+	return true;
+}
+
+void StackSlotAllocator::endVisit(ForStatement const&)
+{
+	m_loopDepth--;
+}
+
+bool StackSlotAllocator::visit(VariableDeclaration const& _variable)
+{
+	recordReference(&_variable);
+	return true;
+}
+
+bool StackSlotAllocator::visit(InlineAssembly const& _inlineAssembly)
+{
+	for (auto const& reference: _inlineAssembly.annotation().externalReferences)
+		recordReference(reference.second.declaration);
+	return false;
+}
+
+void StackSlotAllocator::endVisit(Identifier const& _identifier)
+{
+	recordReference(_identifier.annotation().referencedDeclaration);
+}
+
+void StackSlotAllocator::recordReference(Declaration const* _declaration)
+{
+	auto it = m_references.find(dynamic_cast<VariableDeclaration const*>(_declaration));
+	if (it != m_references.end())
+		it->second.push_back(m_path);
+}
+
+void StackSlotAllocator::allocate(FunctionDefinition const& _function)
+{
+	struct Range
+	{
+		VariableDeclaration const* variable;
+		int start;
+		int end;
+		/// First statement of the range, nullptr if the variable is in use in the whole function.
+		Statement const* first;
+	};
+	vector<Range> ranges;
+	for (VariableDeclaration const* variable: _function.localVariables())
+	{
+		Range range{variable, -1, numeric_limits<int>::max(), nullptr};
+		auto it = m_references.find(variable);
+		if (it != m_references.end() && !it->second.empty())
+		{
+			vector<vector<PathEntry>> const& paths = it->second;
+			// Find the innermost block outside of loops that contains all references.
+			size_t depth = 0;
+			while (all_of(paths.begin(), paths.end(), [&](vector<PathEntry> const& _path) {
+				return
+					_path.size() > depth &&
+					_path[depth].block == paths.front()[depth].block &&
+					!_path[depth].inLoop;
+			}))
+				depth++;
+			if (depth > 0)
+			{
+				size_t first = numeric_limits<size_t>::max();
+				size_t last = 0;
+				for (vector<PathEntry> const& path: paths)
+				{
+					first = min(first, path[depth - 1].statementIndex);
+					last = max(last, path[depth - 1].statementIndex);
+				}
+				Block const& block = *paths.front()[depth - 1].block;
+				range.first = block.statements()[first].get();
+				range.start = range.first->location().start;
+				range.end = block.statements()[last]->location().end;
+			}
+		}
+		ranges.push_back(range);
+	}
+	stable_sort(ranges.begin(), ranges.end(), [](Range const& _a, Range const& _b) { return _a.start < _b.start; });
+
+	// Slots in use together with the end of the range they are used for.
+	vector<pair<int, VariableDeclaration const*>> usedSlots;
+	vector<VariableDeclaration const*> freeSlots;
+	for (Range const& range: ranges)
+	{
+		for (auto it = usedSlots.begin(); it != usedSlots.end();)
+			if (it->first <= range.start)
+			{
+				freeSlots.push_back(it->second);
+				it = usedSlots.erase(it);
+			}
+			else
+				++it;
+		unsigned size = range.variable->annotation().type->sizeOnStack();
+		auto slot = find_if(freeSlots.begin(), freeSlots.end(), [&](VariableDeclaration const* _owner) {
+			return _owner->annotation().type->sizeOnStack() == size;
+		});
+		if (range.first && slot != freeSlots.end())
+		{
+			m_sharedSlots[range.variable] = *slot;
+			m_variablesToReset[range.first].push_back(range.variable);
+			usedSlots.emplace_back(range.end, *slot);
+			freeSlots.erase(slot);
+		}
+		else
+			usedSlots.emplace_back(range.end, range.variable);
+	}
+
+	for (VariableDeclaration const* variable: _function.localVariables())
+		if (!m_sharedSlots.count(variable))
+			m_slotOwners.push_back(variable);
+}
@@ -0,0 +1,94 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Assignment of stack slots to the local variables of a function.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTVisitor.h>
+
+#include <map>
+#include <vector>
+
+namespace dev
+{
+namespace solidity
+{
+
+/**
+ * Assigns stack slots to the local variables of a function such that variables that are
+ * not in use at the same time share a slot.
+ *
+ * A variable is in use from the first to the last statement referencing it in the innermost
+ * block that contains all its references and is not part of a loop. A variable that is
+ * assigned the slot of another variable is reset to its zero value before that range, so
+ * the function behaves as if every variable had its own slot. Variables that are referenced
+ * outside of the function body, and all variables of functions whose body can be executed
+ * more than once per call because of modifiers, get a slot of their own.
+ */
+class StackSlotAllocator: private ASTConstVisitor
+{
+public:
+	/// @param _modifiers the modifiers applied to the function, after resolving virtual modifiers.
+	/// @param _shareSlots if false, every variable gets a slot of its own.
+	StackSlotAllocator(
+		FunctionDefinition const& _function,
+		std::vector<ModifierDefinition const*> const& _modifiers,
+		bool _shareSlots = true
+	);
+
+	/// @returns the local variables that get a slot of their own, in declaration order.
+	std::vector<VariableDeclaration const*> const& slotOwners() const { return m_slotOwners; }
+	/// @returns the variable that owns the slot used by @a _variable, which is @a _variable
+	/// itself if it owns its slot.
+	VariableDeclaration const& slotOwner(VariableDeclaration const& _variable) const;
+	/// @returns the variables that have to be reset to their zero value before @a _statement.
+	std::vector<VariableDeclaration const*> const& variablesToReset(Statement const& _statement) const;
+
+private:
+	/// A statement of a block on the path from the function body to a reference.
+	struct PathEntry
+	{
+		Block const* block;
+		size_t statementIndex;
+		bool inLoop;
+	};
+
+	virtual bool visit(Block const& _block) override;
+	virtual bool visit(WhileStatement const& _whileStatement) override;
+	virtual void endVisit(WhileStatement const& _whileStatement) override;
+	virtual bool visit(ForStatement const& _forStatement) override;
+	virtual void endVisit(ForStatement const& _forStatement) override;
+	virtual bool visit(VariableDeclaration const& _variable) override;
+	virtual bool visit(InlineAssembly const& _inlineAssembly) override;
+	virtual void endVisit(Identifier const& _identifier) override;
+
+	void recordReference(Declaration const* _declaration);
+	void allocate(FunctionDefinition const& _function);
+
+	std::map<VariableDeclaration const*, std::vector<std::vector<PathEntry>>> m_references;
+	std::vector<PathEntry> m_path;
+	unsigned m_loopDepth = 0;
+
+	std::vector<VariableDeclaration const*> m_slotOwners;
+	std::map<VariableDeclaration const*, VariableDeclaration const*> m_sharedSlots;
+	std::map<Statement const*, std::vector<VariableDeclaration const*>> m_variablesToReset;
+};
+
+}
+}
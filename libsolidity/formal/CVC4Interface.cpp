@@ -35,8 +35,11 @@ void CVC4Interface::reset()
 {
 	m_constants.clear();
 	m_functions.clear();
+	m_expressions.clear();
 	m_solver.reset();
 	m_solver.setOption("produce-models", true);
+	if (m_timeout > 0)
+		m_solver.setTimeLimit(m_timeout);
 }
 
 void CVC4Interface::push()
@@ -88,13 +91,30 @@ void CVC4Interface::addAssertion(Expression const& _expr)
 	}
 }
 
-pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const& _expressionsToEvaluate)
+void CVC4Interface::setTimeout(unsigned _milliseconds)
+{
+	m_timeout = _milliseconds;
+	m_solver.setTimeLimit(m_timeout);
+}
+
+pair<CheckResult, vector<string>> CVC4Interface::checkAssuming(
+	vector<Expression> const& _assumptions,
+	vector<Expression> const& _expressionsToEvaluate
+)
 {
 	CheckResult result;
 	vector<string> values;
 	try
 	{
-		switch (m_solver.checkSat().isSat())
+		vector<CVC4::Expr> assumptions;
+		for (Expression const& assumption: _assumptions)
+			assumptions.push_back(toCVC4Expr(assumption));
+		CVC4::Expr assumption;
+		if (assumptions.size() == 1)
+			assumption = assumptions.front();
+		else if (assumptions.size() > 1)
+			assumption = m_context.mkExpr(CVC4::kind::AND, assumptions);
+		switch (m_solver.checkSat(assumption).isSat())
 		{
 		case CVC4::Result::SAT:
 			result = CheckResult::SATISFIABLE;
@@ -109,7 +129,8 @@ pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const&
 			solAssert(false, "");
 		}
 
-		if (result != CheckResult::UNSATISFIABLE && !_expressionsToEvaluate.empty())
+		// There is no model if the check was interrupted, e.g. by the timeout.
+		if (result == CheckResult::SATISFIABLE && !_expressionsToEvaluate.empty())
 		{
 			for (Expression const& e: _expressionsToEvaluate)
 				values.push_back(toString(m_solver.getValue(toCVC4Expr(e))));
@@ -126,13 +147,23 @@ pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const&
 
 CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
 {
-	if (_expr.arguments.empty() && m_constants.count(_expr.name))
-		return m_constants.at(_expr.name);
+	auto it = m_expressions.find(_expr);
+	if (it != m_expressions.end())
+		return it->second;
+	CVC4::Expr expr = newCVC4Expr(_expr);
+	m_expressions.emplace(_expr, expr);
+	return expr;
+}
+
+CVC4::Expr CVC4Interface::newCVC4Expr(Expression const& _expr)
+{
+	if (_expr.arguments().empty() && m_constants.count(_expr.name()))
+		return m_constants.at(_expr.name());
 	vector<CVC4::Expr> arguments;
-	for (auto const& arg: _expr.arguments)
+	for (auto const& arg: _expr.arguments())
 		arguments.push_back(toCVC4Expr(arg));
 
-	string const& n = _expr.name;
+	string const& n = _expr.name();
 	if (m_functions.count(n))
 		return m_context.mkExpr(CVC4::kind::APPLY_UF, m_functions[n], arguments);
 	else if (m_constants.count(n))
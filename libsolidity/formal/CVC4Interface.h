@@ -23,6 +23,8 @@
 
 #include <cvc4/cvc4.h>
 
+#include <unordered_map>
+
 namespace dev
 {
 namespace solidity
@@ -45,16 +47,24 @@ public:
 	Expression newBool(std::string _name) override;
 
 	void addAssertion(Expression const& _expr) override;
-	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void setTimeout(unsigned _milliseconds) override;
+	std::pair<CheckResult, std::vector<std::string>> checkAssuming(
+		std::vector<Expression> const& _assumptions,
+		std::vector<Expression> const& _expressionsToEvaluate
+	) override;
 
 private:
+	/// @returns the translation of @a _expr, every distinct subexpression is translated only once.
 	CVC4::Expr toCVC4Expr(Expression const& _expr);
+	CVC4::Expr newCVC4Expr(Expression const& _expr);
 	CVC4::Type cvc4Sort(smt::Sort _sort);
 
 	CVC4::ExprManager m_context;
 	CVC4::SmtEngine m_solver;
 	std::map<std::string, CVC4::Expr> m_constants;
 	std::map<std::string, CVC4::Expr> m_functions;
+	std::unordered_map<Expression, CVC4::Expr, Expression::IdentityHash, Expression::Identical> m_expressions;
+	unsigned m_timeout = 0;
 };
 
 }
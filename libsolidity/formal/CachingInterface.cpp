@@ -0,0 +1,120 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <libsolidity/formal/CachingInterface.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity::smt;
+
+CachingInterface::CachingInterface(
+	shared_ptr<SolverInterface> _solver,
+	string _solverName,
+	shared_ptr<SMTQueryCache> _cache
+):
+	m_solver(move(_solver)),
+	m_solverName(move(_solverName)),
+	m_cache(move(_cache)),
+	m_queryText(ReadCallback::Callback())
+{
+	solAssert(m_solver && m_cache, "");
+}
+
+void CachingInterface::reset()
+{
+	m_pendingOperations.clear();
+	m_pendingPushes.clear();
+	m_solver->reset();
+	m_queryText.reset();
+}
+
+void CachingInterface::push()
+{
+	m_pendingPushes.push_back(m_pendingOperations.size());
+	m_pendingOperations.emplace_back([this]() { m_solver->push(); });
+	m_queryText.push();
+}
+
+void CachingInterface::pop()
+{
+	if (m_pendingPushes.empty())
+		m_pendingOperations.emplace_back([this]() { m_solver->pop(); });
+	else
+	{
+		// The solver has not seen anything since the corresponding push.
+		m_pendingOperations.resize(m_pendingPushes.back());
+		m_pendingPushes.pop_back();
+	}
+	m_queryText.pop();
+}
+
+Expression CachingInterface::newFunction(string _name, Sort _domain, Sort _codomain)
+{
+	m_queryText.newFunction(_name, _domain, _codomain);
+	m_pendingOperations.emplace_back([=]() { m_solver->newFunction(_name, _domain, _codomain); });
+	return SolverInterface::newFunction(move(_name), _domain, _codomain);
+}
+
+Expression CachingInterface::newInteger(string _name)
+{
+	m_queryText.newInteger(_name);
+	m_pendingOperations.emplace_back([=]() { m_solver->newInteger(_name); });
+	return SolverInterface::newInteger(move(_name));
+}
+
+Expression CachingInterface::newBool(string _name)
+{
+	m_queryText.newBool(_name);
+	m_pendingOperations.emplace_back([=]() { m_solver->newBool(_name); });
+	return SolverInterface::newBool(move(_name));
+}
+
+void CachingInterface::addAssertion(Expression const& _expr)
+{
+	m_queryText.addAssertion(_expr);
+	m_pendingOperations.emplace_back([=]() { m_solver->addAssertion(_expr); });
+}
+
+void CachingInterface::setTimeout(unsigned _milliseconds)
+{
+	// Definite results do not depend on the timeout, so it is not part of the query.
+	m_solver->setTimeout(_milliseconds);
+}
+
+pair<CheckResult, vector<string>> CachingInterface::checkAssuming(
+	vector<Expression> const& _assumptions,
+	vector<Expression> const& _expressionsToEvaluate
+)
+{
+	string query = "; " + m_solverName + "\n" + m_queryText.queryText(_assumptions, _expressionsToEvaluate);
+	SMTQueryCache::Result result;
+	if (!m_cache->lookup(query, result))
+	{
+		forwardPendingOperations();
+		result = m_solver->checkAssuming(_assumptions, _expressionsToEvaluate);
+		m_cache->store(query, result);
+	}
+	return result;
+}
+
+void CachingInterface::forwardPendingOperations()
+{
+	for (auto const& operation: m_pendingOperations)
+		operation();
+	m_pendingOperations.clear();
+	m_pendingPushes.clear();
+}
@@ -0,0 +1,84 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <libsolidity/formal/SolverInterface.h>
+#include <libsolidity/formal/SMTLib2Interface.h>
+#include <libsolidity/formal/SMTQueryCache.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace dev
+{
+namespace solidity
+{
+namespace smt
+{
+
+/**
+ * Solver interface that forwards everything to another solver, but looks up the results
+ * of queries in a cache first. The cache key is the name of the solver together with
+ * the SMT-LIB2 text of the query.
+ * Operations are only forwarded to the solver once a query cannot be answered from the cache.
+ */
+class CachingInterface: public SolverInterface, public boost::noncopyable
+{
+public:
+	CachingInterface(
+		std::shared_ptr<SolverInterface> _solver,
+		std::string _solverName,
+		std::shared_ptr<SMTQueryCache> _cache
+	);
+
+	void reset() override;
+
+	void push() override;
+	void pop() override;
+
+	Expression newFunction(std::string _name, Sort _domain, Sort _codomain) override;
+	Expression newInteger(std::string _name) override;
+	Expression newBool(std::string _name) override;
+
+	void addAssertion(Expression const& _expr) override;
+	void setTimeout(unsigned _milliseconds) override;
+	std::pair<CheckResult, std::vector<std::string>> checkAssuming(
+		std::vector<Expression> const& _assumptions,
+		std::vector<Expression> const& _expressionsToEvaluate
+	) override;
+
+private:
+	/// Performs the operations that have not been forwarded to the solver yet.
+	void forwardPendingOperations();
+
+	std::shared_ptr<SolverInterface> m_solver;
+	std::string m_solverName;
+	std::shared_ptr<SMTQueryCache> m_cache;
+	/// Only used to construct the text of the queries, never queried.
+	SMTLib2Interface m_queryText;
+	std::vector<std::function<void()>> m_pendingOperations;
+	/// Positions of the pending push operations in m_pendingOperations.
+	std::vector<size_t> m_pendingPushes;
+};
+
+}
+}
+}
@@ -25,6 +25,7 @@
 #include <libsolidity/formal/SMTLib2Interface.h>
 #endif
 
+#include <libsolidity/formal/CachingInterface.h>
 #include <libsolidity/formal/SSAVariable.h>
 #include <libsolidity/formal/SymbolicIntVariable.h>
 #include <libsolidity/formal/VariableUsage.h>
@@ -34,11 +35,19 @@
 #include <boost/range/adaptor/map.hpp>
 #include <boost/algorithm/string/replace.hpp>
 
+#include <algorithm>
+
 using namespace std;
 using namespace dev;
 using namespace dev::solidity;
 
-SMTChecker::SMTChecker(ErrorReporter& _errorReporter, ReadCallback::Callback const& _readFileCallback):
+SMTChecker::SMTChecker(
+	ErrorReporter& _errorReporter,
+	ReadCallback::Callback const& _readFileCallback,
+	shared_ptr<smt::SMTQueryCache> const& _queryCache,
+	unsigned _timeout,
+	bool _incremental
+):
 #ifdef HAVE_Z3
 	m_interface(make_shared<smt::Z3Interface>()),
 #elif HAVE_CVC4
@@ -46,29 +55,69 @@ SMTChecker::SMTChecker(ErrorReporter& _errorReporter, ReadCallback::Callback con
 #else
 	m_interface(make_shared<smt::SMTLib2Interface>(_readFileCallback)),
 #endif
+	m_incremental(_incremental),
 	m_errorReporter(_errorReporter)
 {
 	(void)_readFileCallback;
+	if (_timeout > 0)
+		m_interface->setTimeout(_timeout);
+	if (_queryCache)
+	{
+#ifdef HAVE_Z3
+		string solverName = "z3";
+#elif HAVE_CVC4
+		string solverName = "cvc4";
+#else
+		string solverName = "smtlib2";
+#endif
+		m_interface = make_shared<smt::CachingInterface>(m_interface, solverName, _queryCache);
+	}
 }
 
-void SMTChecker::analyze(SourceUnit const& _source)
+vector<SMTChecker::Unit> SMTChecker::units(SourceUnit const& _source)
 {
-	m_variableUsage = make_shared<VariableUsage>(_source);
-	if (_source.annotation().experimentalFeatures.count(ExperimentalFeature::SMTChecker))
-		_source.accept(*this);
-}
+	vector<Unit> units;
+	if (!_source.annotation().experimentalFeatures.count(ExperimentalFeature::SMTChecker))
+		return units;
 
-bool SMTChecker::visit(ContractDefinition const& _contract)
-{
-	for (auto _var : _contract.stateVariables())
-		if (_var->type()->isValueType())
-			createVariable(*_var);
-	return true;
+	shared_ptr<VariableUsage const> variableUsage = make_shared<VariableUsage>(_source);
+	for (auto const& node: _source.nodes())
+		if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
+		{
+			// The first unit contains the base contract specifiers and reports the state variables.
+			Unit unit{contract, {}, true, variableUsage};
+			for (auto const& base: contract->baseContracts())
+				unit.nodes.push_back(base.get());
+			for (auto const& subNode: contract->subNodes())
+				if (dynamic_cast<FunctionDefinition const*>(subNode.get()))
+				{
+					if (unit.reportStateVariables || !unit.nodes.empty())
+						units.push_back(move(unit));
+					units.push_back(Unit{contract, {subNode.get()}, false, variableUsage});
+					unit = Unit{contract, {}, false, variableUsage};
+				}
+				else
+					unit.nodes.push_back(subNode.get());
+			if (unit.reportStateVariables || !unit.nodes.empty())
+				units.push_back(move(unit));
+		}
+	return units;
 }
 
-void SMTChecker::endVisit(ContractDefinition const&)
+void SMTChecker::analyze(Unit const& _unit)
 {
+	m_currentContract = _unit.contract;
+	m_variableUsage = _unit.variableUsage;
+	for (auto const& variable: _unit.contract->stateVariables())
+		if (variable->type()->isValueType())
+			if (_unit.reportStateVariables || SSAVariable::isSupportedType(variable->type()->category()))
+				createVariable(*variable);
+	// Initial values of state variables may refer to other state variables.
+	m_variables.insert(m_stateVariables.begin(), m_stateVariables.end());
+	for (ASTNode const* node: _unit.nodes)
+		node->accept(*this);
 	m_stateVariables.clear();
+	m_currentContract = nullptr;
 }
 
 void SMTChecker::endVisit(VariableDeclaration const& _varDecl)
@@ -571,9 +620,6 @@ void SMTChecker::checkCondition(
 	smt::Expression* _additionalValue
 )
 {
-	m_interface->push();
-	addPathConjoinedExpression(_condition);
-
 	vector<smt::Expression> expressionsToEvaluate;
 	vector<string> expressionNames;
 	if (m_currentFunction)
@@ -595,16 +641,16 @@ void SMTChecker::checkCondition(
 				expressionsToEvaluate.emplace_back(currentValue(*var));
 				expressionNames.push_back(var->name());
 			}
-		for (auto const& var: m_stateVariables)
-			if (knownVariable(*var.first))
+		for (auto const* var: m_currentContract->stateVariables())
+			if (m_stateVariables.count(var) && knownVariable(*var))
 			{
-				expressionsToEvaluate.emplace_back(currentValue(*var.first));
-				expressionNames.push_back(var.first->name());
+				expressionsToEvaluate.emplace_back(currentValue(*var));
+				expressionNames.push_back(var->name());
 			}
 	}
 	smt::CheckResult result;
 	vector<string> values;
-	tie(result, values) = checkSatisfiableAndGenerateModel(expressionsToEvaluate);
+	tie(result, values) = checkPathConditionsAnd(_condition, expressionsToEvaluate);
 
 	string loopComment;
 	if (m_loopExecutionHappened)
@@ -622,7 +668,7 @@ void SMTChecker::checkCondition(
 			message << " for:\n";
 			solAssert(values.size() == expressionNames.size(), "");
 			for (size_t i = 0; i < values.size(); ++i)
-				if (expressionsToEvaluate.at(i).name != values.at(i))
+				if (expressionsToEvaluate.at(i).name() != values.at(i))
 					message << "  " << expressionNames.at(i) << " = " << values.at(i) << "\n";
 		}
 		else
@@ -641,7 +687,6 @@ void SMTChecker::checkCondition(
 	default:
 		solAssert(false, "");
 	}
-	m_interface->pop();
 }
 
 void SMTChecker::checkBooleanNotConstant(Expression const& _condition, string const& _description)
@@ -650,15 +695,8 @@ void SMTChecker::checkBooleanNotConstant(Expression const& _condition, string co
 	if (dynamic_cast<Literal const*>(&_condition))
 		return;
 
-	m_interface->push();
-	addPathConjoinedExpression(expr(_condition));
-	auto positiveResult = checkSatisfiable();
-	m_interface->pop();
-
-	m_interface->push();
-	addPathConjoinedExpression(!expr(_condition));
-	auto negatedResult = checkSatisfiable();
-	m_interface->pop();
+	auto positiveResult = checkPathConditionsAnd(expr(_condition)).first;
+	auto negatedResult = checkPathConditionsAnd(!expr(_condition)).first;
 
 	if (positiveResult == smt::CheckResult::ERROR || negatedResult == smt::CheckResult::ERROR)
 		m_errorReporter.warning(_condition.location(), "Error trying to invoke SMT solver.");
@@ -687,13 +725,34 @@ void SMTChecker::checkBooleanNotConstant(Expression const& _condition, string co
 }
 
 pair<smt::CheckResult, vector<string>>
-SMTChecker::checkSatisfiableAndGenerateModel(vector<smt::Expression> const& _expressionsToEvaluate)
+SMTChecker::checkPathConditionsAnd(smt::Expression const& _condition, vector<smt::Expression> const& _expressionsToEvaluate)
+{
+	if (m_incremental)
+	{
+		// The target only holds if the literal is assumed, so it does not constrain later checks.
+		smt::Expression target = newLiteral("target");
+		m_interface->addAssertion(smt::Expression::implies(target, currentPathConditions() && _condition));
+		return checkSatisfiableAndGenerateModel({target}, _expressionsToEvaluate);
+	}
+
+	m_interface->push();
+	addPathConjoinedExpression(_condition);
+	auto result = checkSatisfiableAndGenerateModel({}, _expressionsToEvaluate);
+	m_interface->pop();
+	return result;
+}
+
+pair<smt::CheckResult, vector<string>>
+SMTChecker::checkSatisfiableAndGenerateModel(
+	vector<smt::Expression> const& _assumptions,
+	vector<smt::Expression> const& _expressionsToEvaluate
+)
 {
 	smt::CheckResult result;
 	vector<string> values;
 	try
 	{
-		tie(result, values) = m_interface->check(_expressionsToEvaluate);
+		tie(result, values) = m_interface->checkAssuming(_assumptions, _expressionsToEvaluate);
 	}
 	catch (smt::SolverError const& _e)
 	{
@@ -717,9 +776,9 @@ SMTChecker::checkSatisfiableAndGenerateModel(vector<smt::Expression> const& _exp
 	return make_pair(result, values);
 }
 
-smt::CheckResult SMTChecker::checkSatisfiable()
+smt::Expression SMTChecker::newLiteral(string const& _prefix)
 {
-	return checkSatisfiableAndGenerateModel({}).first;
+	return m_interface->newBool(_prefix + "_" + to_string(m_literals++));
 }
 
 void SMTChecker::initializeLocalVariables(FunctionDefinition const& _function)
@@ -740,11 +799,13 @@ void SMTChecker::initializeLocalVariables(FunctionDefinition const& _function)
 
 void SMTChecker::resetStateVariables()
 {
-	for (auto const& variable: m_stateVariables)
-	{
-		newValue(*variable.first);
-		setUnknownValue(*variable.first);
-	}
+	// In declaration order, the order of m_stateVariables depends on the memory layout.
+	for (auto const* variable: m_currentContract->stateVariables())
+		if (m_stateVariables.count(variable))
+		{
+			newValue(*variable);
+			setUnknownValue(*variable);
+		}
 }
 
 void SMTChecker::resetVariables(vector<Declaration const*> _variables)
@@ -758,7 +819,10 @@ void SMTChecker::resetVariables(vector<Declaration const*> _variables)
 
 void SMTChecker::mergeVariables(vector<Declaration const*> const& _variables, smt::Expression const& _condition, VariableSequenceCounters const& _countersEndTrue, VariableSequenceCounters const& _countersEndFalse)
 {
-	set<Declaration const*> uniqueVars(_variables.begin(), _variables.end());
+	// Merged in the order of the node IDs, like the touched variables are ordered.
+	vector<Declaration const*> uniqueVars = _variables;
+	sort(uniqueVars.begin(), uniqueVars.end(), [](Declaration const* _a, Declaration const* _b) { return _a->id() < _b->id(); });
+	uniqueVars.erase(unique(uniqueVars.begin(), uniqueVars.end()), uniqueVars.end());
 	for (auto const* decl: uniqueVars)
 	{
 		int trueCounter = _countersEndTrue.at(decl).index();
@@ -890,7 +954,15 @@ void SMTChecker::popPathCondition()
 
 void SMTChecker::pushPathCondition(smt::Expression const& _e)
 {
-	m_pathConditions.push_back(currentPathConditions() && _e);
+	smt::Expression condition = currentPathConditions() && _e;
+	if (m_incremental)
+	{
+		// Expressions guarded by the path conditions only refer to the literal.
+		smt::Expression literal = newLiteral("path_condition");
+		m_interface->addAssertion(literal == condition);
+		condition = literal;
+	}
+	m_pathConditions.push_back(condition);
 }
 
 smt::Expression SMTChecker::currentPathConditions()
@@ -27,6 +27,7 @@
 #include <libsolidity/interface/ReadFile.h>
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -38,20 +39,51 @@ namespace solidity
 class VariableUsage;
 class ErrorReporter;
 
+namespace smt
+{
+class SMTQueryCache;
+}
+
 class SMTChecker: private ASTConstVisitor
 {
 public:
-	SMTChecker(ErrorReporter& _errorReporter, ReadCallback::Callback const& _readCallback);
+	/// @param _queryCache if not null, the results of queries are looked up there first
+	/// and stored there afterwards.
+	/// @param _timeout if positive, the time limit of each query in milliseconds.
+	/// @param _incremental if true, path conditions and verification targets are represented
+	/// by literals and targets are checked using assumptions instead of push and pop, so that
+	/// the solver can re-use what it has learned for later targets.
+	SMTChecker(
+		ErrorReporter& _errorReporter,
+		ReadCallback::Callback const& _readCallback,
+		std::shared_ptr<smt::SMTQueryCache> const& _queryCache = nullptr,
+		unsigned _timeout = 0,
+		bool _incremental = false
+	);
+
+	/// Part of a contract that can be analyzed independently of the rest of the contract,
+	/// i.e. a function or a sequence of other nodes of the contract.
+	struct Unit
+	{
+		ContractDefinition const* contract;
+		std::vector<ASTNode const*> nodes;
+		/// Whether to warn about state variables of unsupported types.
+		bool reportStateVariables;
+		std::shared_ptr<VariableUsage const> variableUsage;
+	};
 
-	void analyze(SourceUnit const& _sources);
+	/// @returns the units of @a _source in the order in which they are visited,
+	/// or an empty vector if the source does not enable the SMT checker.
+	/// The units can be analyzed by separate checkers, also concurrently.
+	static std::vector<Unit> units(SourceUnit const& _source);
+
+	void analyze(Unit const& _unit);
 
 private:
 	// TODO: Check that we do not have concurrent reads and writes to a variable,
 	// because the order of expression evaluation is undefined
 	// TODO: or just force a certain order, but people might have a different idea about that.
 
-	virtual bool visit(ContractDefinition const& _node) override;
-	virtual void endVisit(ContractDefinition const& _node) override;
 	virtual void endVisit(VariableDeclaration const& _node) override;
 	virtual bool visit(FunctionDefinition const& _node) override;
 	virtual void endVisit(FunctionDefinition const& _node) override;
@@ -107,10 +139,19 @@ private:
 	void checkUnderOverflow(smt::Expression _value, IntegerType const& _Type, SourceLocation const& _location);
 
 
+	/// Checks whether @a _condition can hold together with the current path conditions
+	/// and evaluates the expressions if this is the case.
+	std::pair<smt::CheckResult, std::vector<std::string>>
+	checkPathConditionsAnd(smt::Expression const& _condition, std::vector<smt::Expression> const& _expressionsToEvaluate = {});
+
 	std::pair<smt::CheckResult, std::vector<std::string>>
-	checkSatisfiableAndGenerateModel(std::vector<smt::Expression> const& _expressionsToEvaluate);
+	checkSatisfiableAndGenerateModel(
+		std::vector<smt::Expression> const& _assumptions,
+		std::vector<smt::Expression> const& _expressionsToEvaluate
+	);
 
-	smt::CheckResult checkSatisfiable();
+	/// @returns a new boolean constant that is used as an assumption literal in incremental mode.
+	smt::Expression newLiteral(std::string const& _prefix);
 
 	void initializeLocalVariables(FunctionDefinition const& _function);
 	void resetStateVariables();
@@ -154,7 +195,8 @@ private:
 	void pushPathCondition(smt::Expression const& _e);
 	/// Remove the last path condition
 	void popPathCondition();
-	/// Returns the conjunction of all path conditions or True if empty
+	/// Returns the conjunction of all path conditions or True if empty.
+	/// In incremental mode, this is a literal that is equivalent to the conjunction.
 	smt::Expression currentPathConditions();
 	/// Conjoin the current path conditions with the given parameter and add to the solver
 	void addPathConjoinedExpression(smt::Expression const& _e);
@@ -162,7 +204,9 @@ private:
 	void addPathImpliedExpression(smt::Expression const& _e);
 
 	std::shared_ptr<smt::SolverInterface> m_interface;
-	std::shared_ptr<VariableUsage> m_variableUsage;
+	bool m_incremental;
+	unsigned m_literals = 0;
+	std::shared_ptr<VariableUsage const> m_variableUsage;
 	bool m_loopExecutionHappened = false;
 	std::map<Expression const*, smt::Expression> m_expressions;
 	std::map<Declaration const*, SSAVariable> m_variables;
@@ -170,6 +214,7 @@ private:
 	std::vector<smt::Expression> m_pathConditions;
 	ErrorReporter& m_errorReporter;
 
+	ContractDefinition const* m_currentContract = nullptr;
 	FunctionDefinition const* m_currentFunction = nullptr;
 };
 
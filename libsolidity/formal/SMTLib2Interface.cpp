@@ -93,12 +93,17 @@ void SMTLib2Interface::addAssertion(Expression const& _expr)
 	write("(assert " + toSExpr(_expr) + ")");
 }
 
-pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<Expression> const& _expressionsToEvaluate)
+void SMTLib2Interface::setTimeout(unsigned)
 {
-	string response = querySolver(
-		boost::algorithm::join(m_accumulatedOutput, "\n") +
-		checkSatAndGetValuesCommand(_expressionsToEvaluate)
-	);
+	// There is no standard option for timeouts, the query callback has to limit the time.
+}
+
+pair<CheckResult, vector<string>> SMTLib2Interface::checkAssuming(
+	vector<Expression> const& _assumptions,
+	vector<Expression> const& _expressionsToEvaluate
+)
+{
+	string response = querySolver(queryText(_assumptions, _expressionsToEvaluate));
 
 	CheckResult result;
 	// TODO proper parsing
@@ -117,12 +122,19 @@ pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<Expression> con
 	return make_pair(result, values);
 }
 
+string SMTLib2Interface::queryText(vector<Expression> const& _assumptions, vector<Expression> const& _expressionsToEvaluate)
+{
+	return
+		boost::algorithm::join(m_accumulatedOutput, "\n") +
+		checkSatAndGetValuesCommand(_assumptions, _expressionsToEvaluate);
+}
+
 string SMTLib2Interface::toSExpr(Expression const& _expr)
 {
-	if (_expr.arguments.empty())
-		return _expr.name;
-	std::string sexpr = "(" + _expr.name;
-	for (auto const& arg: _expr.arguments)
+	if (_expr.arguments().empty())
+		return _expr.name();
+	std::string sexpr = "(" + _expr.name();
+	for (auto const& arg: _expr.arguments())
 		sexpr += " " + toSExpr(arg);
 	sexpr += ")";
 	return sexpr;
@@ -134,22 +146,37 @@ void SMTLib2Interface::write(string _data)
 	m_accumulatedOutput.back() += move(_data) + "\n";
 }
 
-string SMTLib2Interface::checkSatAndGetValuesCommand(vector<Expression> const& _expressionsToEvaluate)
+string SMTLib2Interface::checkSatAndGetValuesCommand(
+	vector<Expression> const& _assumptions,
+	vector<Expression> const& _expressionsToEvaluate
+)
 {
+	string checkSat = "(check-sat)\n";
+	if (!_assumptions.empty())
+	{
+		vector<string> literals;
+		for (Expression const& assumption: _assumptions)
+		{
+			solAssert(assumption.sort() == Sort::Bool && assumption.arguments().empty(), "Assumptions have to be boolean constants.");
+			literals.push_back(toSExpr(assumption));
+		}
+		checkSat = "(check-sat-assuming (" + boost::algorithm::join(literals, " ") + "))\n";
+	}
+
 	string command;
 	if (_expressionsToEvaluate.empty())
-		command = "(check-sat)\n";
+		command = checkSat;
 	else
 	{
 		// TODO make sure these are unique
 		for (size_t i = 0; i < _expressionsToEvaluate.size(); i++)
 		{
 			auto const& e = _expressionsToEvaluate.at(i);
-			solAssert(e.sort == Sort::Int || e.sort == Sort::Bool, "Invalid sort for expression to evaluate.");
-			command += "(declare-const |EVALEXPR_" + to_string(i) + "| " + (e.sort == Sort::Int ? "Int" : "Bool") + "\n";
+			solAssert(e.sort() == Sort::Int || e.sort() == Sort::Bool, "Invalid sort for expression to evaluate.");
+			command += "(declare-const |EVALEXPR_" + to_string(i) + "| " + (e.sort() == Sort::Int ? "Int" : "Bool") + "\n";
 			command += "(assert (= |EVALEXPR_" + to_string(i) + "| " + toSExpr(e) + "))\n";
 		}
-		command += "(check-sat)\n";
+		command += checkSat;
 		command += "(get-value (";
 		for (size_t i = 0; i < _expressionsToEvaluate.size(); i++)
 			command += "|EVALEXPR_" + to_string(i) + "| ";
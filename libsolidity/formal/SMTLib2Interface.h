@@ -53,14 +53,24 @@ public:
 	Expression newBool(std::string _name) override;
 
 	void addAssertion(Expression const& _expr) override;
-	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void setTimeout(unsigned _milliseconds) override;
+	std::pair<CheckResult, std::vector<std::string>> checkAssuming(
+		std::vector<Expression> const& _assumptions,
+		std::vector<Expression> const& _expressionsToEvaluate
+	) override;
+
+	/// @returns the SMT-LIB2 script that checkAssuming() sends to the solver for the current assertions.
+	std::string queryText(std::vector<Expression> const& _assumptions, std::vector<Expression> const& _expressionsToEvaluate);
 
 private:
 	std::string toSExpr(Expression const& _expr);
 
 	void write(std::string _data);
 
-	std::string checkSatAndGetValuesCommand(std::vector<Expression> const& _expressionsToEvaluate);
+	std::string checkSatAndGetValuesCommand(
+		std::vector<Expression> const& _assumptions,
+		std::vector<Expression> const& _expressionsToEvaluate
+	);
 	std::vector<std::string> parseValues(std::string::const_iterator _start, std::string::const_iterator _end);
 
 	/// Communicates with the solver via the callback. Throws SMTSolverError on error.
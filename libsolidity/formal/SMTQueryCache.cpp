@@ -0,0 +1,122 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <libsolidity/formal/SMTQueryCache.h>
+
+#include <libdevcore/SHA3.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity::smt;
+
+bool SMTQueryCache::lookup(string const& _query, Result& o_result)
+{
+	h256 hash = keccak256(_query);
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_results.find(hash);
+	if (it == m_results.end())
+	{
+		++m_misses;
+		return false;
+	}
+	++m_hits;
+	it->second.used = true;
+	o_result = it->second.result;
+	return true;
+}
+
+void SMTQueryCache::store(string const& _query, Result const& _result)
+{
+	// Unknown results might be due to resource limits and are not cached.
+	if (_result.first != CheckResult::SATISFIABLE && _result.first != CheckResult::UNSATISFIABLE)
+		return;
+	h256 hash = keccak256(_query);
+	lock_guard<mutex> lock(m_mutex);
+	m_results[hash] = Entry{_result, true};
+}
+
+size_t SMTQueryCache::size() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_results.size();
+}
+
+unsigned SMTQueryCache::hits() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_hits;
+}
+
+unsigned SMTQueryCache::misses() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_misses;
+}
+
+Json::Value SMTQueryCache::toJson() const
+{
+	// Every query is stored as "hash": ["sat", values...] or "hash": ["unsat"].
+	Json::Value json(Json::objectValue);
+	lock_guard<mutex> lock(m_mutex);
+	for (auto const& result: m_results)
+	{
+		if (!result.second.used)
+			continue;
+		Json::Value entry(Json::arrayValue);
+		entry.append(result.second.result.first == CheckResult::SATISFIABLE ? "sat" : "unsat");
+		for (string const& value: result.second.result.second)
+			entry.append(value);
+		json[result.first.hex()] = entry;
+	}
+	return json;
+}
+
+bool SMTQueryCache::addFromJson(Json::Value const& _json)
+{
+	if (!_json.isObject())
+		return false;
+
+	map<h256, Result> results;
+	for (auto it = _json.begin(); it != _json.end(); ++it)
+	{
+		bytes hash = fromHex(it.key().asString(), WhenError::DontThrow);
+		Json::Value const& entry = *it;
+		if (hash.size() != h256::size || !entry.isArray() || entry.empty() || !entry[0].isString())
+			return false;
+
+		Result result;
+		if (entry[0].asString() == "sat")
+			result.first = CheckResult::SATISFIABLE;
+		else if (entry[0].asString() == "unsat" && entry.size() == 1)
+			result.first = CheckResult::UNSATISFIABLE;
+		else
+			return false;
+		for (Json::ArrayIndex i = 1; i < entry.size(); ++i)
+		{
+			if (!entry[i].isString())
+				return false;
+			result.second.push_back(entry[i].asString());
+		}
+		results[h256(hash)] = move(result);
+	}
+
+	lock_guard<mutex> lock(m_mutex);
+	for (auto& result: results)
+		// Results that are already known keep their state of use.
+		m_results.insert(make_pair(result.first, Entry{move(result.second), false}));
+	return true;
+}
@@ -0,0 +1,85 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <libsolidity/formal/SolverInterface.h>
+
+#include <libdevcore/FixedHash.h>
+
+#include <json/json.h>
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace dev
+{
+namespace solidity
+{
+namespace smt
+{
+
+/**
+ * Results of SMT queries, keyed by the hash of the SMT-LIB2 text of the query.
+ * Only definite results (satisfiable with model or unsatisfiable) are stored.
+ * The cache can be converted to and from JSON to re-use it across compiler runs.
+ * Only the results that were looked up or stored since the cache was created are
+ * converted to JSON, so that results of queries the sources no longer produce do
+ * not accumulate.
+ * Lookups and stores can be performed concurrently.
+ */
+class SMTQueryCache
+{
+public:
+	using Result = std::pair<CheckResult, std::vector<std::string>>;
+
+	/// Looks up the result of @a _query and counts a hit or a miss.
+	/// @returns true and sets @a o_result if the result is known.
+	bool lookup(std::string const& _query, Result& o_result);
+	/// Stores the result of @a _query, unless it is not definite.
+	void store(std::string const& _query, Result const& _result);
+
+	/// @returns the number of results, including the ones that have not been used.
+	size_t size() const;
+	unsigned hits() const;
+	unsigned misses() const;
+
+	/// @returns the results that have been looked up or stored.
+	Json::Value toJson() const;
+	/// Adds the results contained in @a _json, which has to be the output of toJson.
+	/// They are not used by this.
+	/// @returns false if @a _json is malformed. In that case, nothing is added.
+	bool addFromJson(Json::Value const& _json);
+
+private:
+	struct Entry
+	{
+		Result result;
+		bool used;
+	};
+
+	mutable std::mutex m_mutex;
+	std::map<h256, Entry> m_results;
+	unsigned m_hits = 0;
+	unsigned m_misses = 0;
+};
+
+}
+}
+}
@@ -0,0 +1,132 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <libsolidity/formal/SolverInterface.h>
+
+#include <boost/functional/hash.hpp>
+
+#include <mutex>
+#include <set>
+#include <unordered_map>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity::smt;
+
+namespace
+{
+
+/// @returns the interned copy of @a _name if it is the name of an operator or a boolean
+/// constant and nullptr otherwise.
+string const* internedName(string const& _name)
+{
+	static set<string> const names{
+		"ite", "not", "and", "or", "=", "<", "<=", ">", ">=", "+", "-", "*", "/", "true", "false"
+	};
+	auto it = names.find(_name);
+	return it == names.end() ? nullptr : &*it;
+}
+
+}
+
+/// All nodes that are currently alive, by hash. Nodes remove themselves when they are destroyed.
+/// Expressions can be created concurrently, so accesses are guarded by mutexes. The table is
+/// split into shards by hash, each with a mutex of its own, so that the SMT checker running
+/// on several threads does not serialise on a single lock.
+struct Expression::Table
+{
+	struct Shard
+	{
+		std::mutex mutex;
+		unordered_multimap<size_t, pair<Node const*, weak_ptr<Node const>>> nodes;
+	};
+
+	static size_t const c_shards = 64;
+	Shard shards[c_shards];
+
+	/// @returns the shard that contains the nodes with hash @a _hash.
+	static Shard& shard(size_t _hash)
+	{
+		// Never destroyed, expressions with static storage duration might outlive it otherwise.
+		static Table* table = new Table();
+		return table->shards[_hash % c_shards];
+	}
+};
+
+Expression::Node::Node(string const& _name, vector<Expression> _arguments, Sort _sort, size_t _hash):
+	name(internedName(_name)),
+	arguments(move(_arguments)),
+	sort(_sort),
+	hash(_hash)
+{
+	if (!name)
+	{
+		ownName.reset(new string(_name));
+		name = ownName.get();
+	}
+}
+
+Expression::Node::~Node()
+{
+	Table::Shard& shard = Table::shard(hash);
+	lock_guard<std::mutex> lock(shard.mutex);
+	auto range = shard.nodes.equal_range(hash);
+	for (auto it = range.first; it != range.second; ++it)
+		if (it->second.first == this)
+		{
+			shard.nodes.erase(it);
+			break;
+		}
+}
+
+Expression::Expression(string const& _name, vector<Expression> _arguments, Sort _sort)
+{
+	size_t hash = std::hash<string>()(_name);
+	boost::hash_combine(hash, static_cast<int>(_sort));
+	for (Expression const& argument: _arguments)
+		boost::hash_combine(hash, argument.m_node.get());
+
+	Table::Shard& shard = Table::shard(hash);
+	// Locked nodes that do not match are released only after the mutex, because
+	// the last reference might be among them and their destructor needs the mutex
+	// of the same shard.
+	vector<shared_ptr<Node const>> mismatches;
+	lock_guard<std::mutex> lock(shard.mutex);
+	auto range = shard.nodes.equal_range(hash);
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		// Nodes that are being destroyed cannot be locked anymore.
+		shared_ptr<Node const> node = it->second.second.lock();
+		if (!node)
+			continue;
+		bool matches =
+			node->sort == _sort &&
+			*node->name == _name &&
+			node->arguments.size() == _arguments.size();
+		for (size_t i = 0; matches && i < _arguments.size(); ++i)
+			matches = node->arguments[i].m_node == _arguments[i].m_node;
+		if (matches)
+		{
+			m_node = move(node);
+			return;
+		}
+		mismatches.push_back(move(node));
+	}
+	auto node = make_shared<Node const>(_name, move(_arguments), _sort, hash);
+	shard.nodes.emplace(hash, make_pair(node.get(), weak_ptr<Node const>(node)));
+	m_node = move(node);
+}
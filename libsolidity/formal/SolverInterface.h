@@ -26,6 +26,7 @@
 #include <boost/noncopyable.hpp>
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 #include <cstdio>
@@ -51,14 +52,17 @@ enum class Sort
 };
 
 /// C++ representation of an SMTLIB2 expression.
+/// Expressions are immutable, reference-counted nodes of a directed acyclic graph.
+/// Structurally equal expressions share the same node (hash-consing), so neither copying
+/// an expression nor using it as an argument of another expression copies any subexpression.
 class Expression
 {
 	friend class SolverInterface;
 public:
-	explicit Expression(bool _v): name(_v ? "true" : "false"), sort(Sort::Bool) {}
-	Expression(size_t _number): name(std::to_string(_number)), sort(Sort::Int) {}
-	Expression(u256 const& _number): name(_number.str()), sort(Sort::Int) {}
-	Expression(bigint const& _number): name(_number.str()), sort(Sort::Int) {}
+	explicit Expression(bool _v): Expression(_v ? "true" : "false", Sort::Bool) {}
+	Expression(size_t _number): Expression(std::to_string(_number), Sort::Int) {}
+	Expression(u256 const& _number): Expression(_number.str(), Sort::Int) {}
+	Expression(bigint const& _number): Expression(_number.str(), Sort::Int) {}
 
 	Expression(Expression const&) = default;
 	Expression(Expression&&) = default;
@@ -82,15 +86,16 @@ public:
 			{"*", 2},
 			{"/", 2}
 		};
-		return operatorsArity.count(name) && operatorsArity.at(name) == arguments.size();
+		return operatorsArity.count(name()) && operatorsArity.at(name()) == arguments().size();
 	}
 
 	static Expression ite(Expression _condition, Expression _trueValue, Expression _falseValue)
 	{
-		solAssert(_trueValue.sort == _falseValue.sort, "");
+		solAssert(_trueValue.sort() == _falseValue.sort(), "");
+		Sort sort = _trueValue.sort();
 		return Expression("ite", std::vector<Expression>{
 			std::move(_condition), std::move(_trueValue), std::move(_falseValue)
-		}, _trueValue.sort);
+		}, sort);
 	}
 
 	static Expression implies(Expression _a, Expression _b)
@@ -153,15 +158,15 @@ public:
 	Expression operator()(Expression _a) const
 	{
 		solAssert(
-			arguments.empty(),
+			arguments().empty(),
 			"Attempted function application to non-function."
 		);
-		switch (sort)
+		switch (sort())
 		{
 		case Sort::IntIntFun:
-			return Expression(name, _a, Sort::Int);
+			return Expression(name(), std::move(_a), Sort::Int);
 		case Sort::IntBoolFun:
-			return Expression(name, _a, Sort::Bool);
+			return Expression(name(), std::move(_a), Sort::Bool);
 		default:
 			solAssert(
 				false,
@@ -171,23 +176,62 @@ public:
 		}
 	}
 
-	std::string const name;
-	std::vector<Expression> const arguments;
-	Sort sort;
+	std::string const& name() const;
+	std::vector<Expression> const& arguments() const;
+	Sort sort() const;
+
+	/// @returns true if this and @a _other are structurally equal, which is the case
+	/// iff they share the same node. Note that operator== creates an equality expression.
+	bool identical(Expression const& _other) const { return m_node == _other.m_node; }
+
+	/// Hash and equality of unordered containers that map structurally equal expressions
+	/// to the same entry, e.g. to translate every distinct subexpression only once.
+	struct IdentityHash
+	{
+		size_t operator()(Expression const& _expr) const { return std::hash<void const*>()(_expr.m_node.get()); }
+	};
+	struct Identical
+	{
+		bool operator()(Expression const& _a, Expression const& _b) const { return _a.identical(_b); }
+	};
 
 private:
+	struct Node;
+	struct Table;
+
 	/// Manual constructor, should only be used by SolverInterface and this class itself.
-	Expression(std::string _name, std::vector<Expression> _arguments, Sort _sort):
-		name(std::move(_name)), arguments(std::move(_arguments)), sort(_sort) {}
-
-	explicit Expression(std::string _name, Sort _sort):
-		Expression(std::move(_name), std::vector<Expression>{}, _sort) {}
-	Expression(std::string _name, Expression _arg, Sort _sort):
-		Expression(std::move(_name), std::vector<Expression>{std::move(_arg)}, _sort) {}
-	Expression(std::string _name, Expression _arg1, Expression _arg2, Sort _sort):
-		Expression(std::move(_name), std::vector<Expression>{std::move(_arg1), std::move(_arg2)}, _sort) {}
+	/// Looks up the node of a structurally equal expression and creates it if there is none.
+	Expression(std::string const& _name, std::vector<Expression> _arguments, Sort _sort);
+
+	explicit Expression(std::string const& _name, Sort _sort):
+		Expression(_name, std::vector<Expression>{}, _sort) {}
+	Expression(std::string const& _name, Expression _arg, Sort _sort):
+		Expression(_name, std::vector<Expression>{std::move(_arg)}, _sort) {}
+	Expression(std::string const& _name, Expression _arg1, Expression _arg2, Sort _sort):
+		Expression(_name, std::vector<Expression>{std::move(_arg1), std::move(_arg2)}, _sort) {}
+
+	std::shared_ptr<Node const> m_node;
 };
 
+/// Node of the expression graph, shared by all structurally equal expressions.
+struct Expression::Node: boost::noncopyable
+{
+	Node(std::string const& _name, std::vector<Expression> _arguments, Sort _sort, size_t _hash);
+	/// Removes the node from the table of nodes.
+	~Node();
+
+	/// Interned for operators and constants, otherwise points to ownName.
+	std::string const* name;
+	std::unique_ptr<std::string const> ownName;
+	std::vector<Expression> const arguments;
+	Sort const sort;
+	size_t const hash;
+};
+
+inline std::string const& Expression::name() const { return *m_node->name; }
+inline std::vector<Expression> const& Expression::arguments() const { return m_node->arguments; }
+inline Sort Expression::sort() const { return m_node->sort; }
+
 DEV_SIMPLE_EXCEPTION(SolverError);
 
 class SolverInterface
@@ -206,9 +250,9 @@ public:
 		switch (_codomain)
 		{
 		case Sort::Int:
-			return Expression(std::move(_name), {}, Sort::IntIntFun);
+			return Expression(_name, Sort::IntIntFun);
 		case Sort::Bool:
-			return Expression(std::move(_name), {}, Sort::IntBoolFun);
+			return Expression(_name, Sort::IntBoolFun);
 		default:
 			solAssert(false, "Function sort not supported.");
 			break;
@@ -217,20 +261,33 @@ public:
 	virtual Expression newInteger(std::string _name)
 	{
 		// Subclasses should do something here
-		return Expression(std::move(_name), {}, Sort::Int);
+		return Expression(_name, Sort::Int);
 	}
 	virtual Expression newBool(std::string _name)
 	{
 		// Subclasses should do something here
-		return Expression(std::move(_name), {}, Sort::Bool);
+		return Expression(_name, Sort::Bool);
 	}
 
 	virtual void addAssertion(Expression const& _expr) = 0;
 
+	/// Limits the time of each check to @a _milliseconds. Checks that reach the limit
+	/// return CheckResult::UNKNOWN.
+	virtual void setTimeout(unsigned _milliseconds) = 0;
+
 	/// Checks for satisfiability, evaluates the expressions if a model
 	/// is available. Throws SMTSolverError on error.
+	std::pair<CheckResult, std::vector<std::string>>
+	check(std::vector<Expression> const& _expressionsToEvaluate)
+	{
+		return checkAssuming({}, _expressionsToEvaluate);
+	}
+	/// Checks for satisfiability like check, but additionally assumes that the boolean
+	/// constants @a _assumptions are true without asserting them (check-sat-assuming).
+	/// Unlike assertions that are added and removed again using push and pop, this
+	/// allows the solver to keep what it has learned for later checks.
 	virtual std::pair<CheckResult, std::vector<std::string>>
-	check(std::vector<Expression> const& _expressionsToEvaluate) = 0;
+	checkAssuming(std::vector<Expression> const& _assumptions, std::vector<Expression> const& _expressionsToEvaluate) = 0;
 };
 
 
@@ -55,7 +55,9 @@ vector<Declaration const*> VariableUsage::touchedVariables(ASTNode const& _node)
 	if (!m_children.count(&_node) && !m_touchedVariable.count(&_node))
 		return {};
 
-	set<Declaration const*> touched;
+	// Ordered by node ID and not by address, so that the queries do not depend on memory layout.
+	auto byID = [](Declaration const* _a, Declaration const* _b) { return _a->id() < _b->id(); };
+	set<Declaration const*, decltype(byID)> touched(byID);
 	vector<ASTNode const*> toVisit;
 	toVisit.push_back(&_node);
 
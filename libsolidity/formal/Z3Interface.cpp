@@ -28,13 +28,20 @@ using namespace dev::solidity::smt;
 Z3Interface::Z3Interface():
 	m_solver(m_context)
 {
-	z3::set_param("rewriter.pull_cheap_ite", true);
+	// Global parameters must not be set concurrently.
+	static bool const globalParametersSet = []()
+	{
+		z3::set_param("rewriter.pull_cheap_ite", true);
+		return true;
+	}();
+	(void)globalParametersSet;
 }
 
 void Z3Interface::reset()
 {
 	m_constants.clear();
 	m_functions.clear();
+	m_expressions.clear();
 	m_solver.reset();
 }
 
@@ -71,13 +78,26 @@ void Z3Interface::addAssertion(Expression const& _expr)
 	m_solver.add(toZ3Expr(_expr));
 }
 
-pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _expressionsToEvaluate)
+void Z3Interface::setTimeout(unsigned _milliseconds)
+{
+	z3::params parameters(m_context);
+	parameters.set("timeout", _milliseconds);
+	m_solver.set(parameters);
+}
+
+pair<CheckResult, vector<string>> Z3Interface::checkAssuming(
+	vector<Expression> const& _assumptions,
+	vector<Expression> const& _expressionsToEvaluate
+)
 {
 	CheckResult result;
 	vector<string> values;
 	try
 	{
-		switch (m_solver.check())
+		z3::expr_vector assumptions(m_context);
+		for (Expression const& assumption: _assumptions)
+			assumptions.push_back(toZ3Expr(assumption));
+		switch (m_solver.check(assumptions))
 		{
 		case z3::check_result::sat:
 			result = CheckResult::SATISFIABLE;
@@ -92,7 +112,8 @@ pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _
 			solAssert(false, "");
 		}
 
-		if (result != CheckResult::UNSATISFIABLE && !_expressionsToEvaluate.empty())
+		// There is no model if the check was interrupted, e.g. by the timeout.
+		if (result == CheckResult::SATISFIABLE && !_expressionsToEvaluate.empty())
 		{
 			z3::model m = m_solver.get_model();
 			for (Expression const& e: _expressionsToEvaluate)
@@ -110,13 +131,23 @@ pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _
 
 z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 {
-	if (_expr.arguments.empty() && m_constants.count(_expr.name))
-		return m_constants.at(_expr.name);
+	auto it = m_expressions.find(_expr);
+	if (it != m_expressions.end())
+		return it->second;
+	z3::expr expr = newZ3Expr(_expr);
+	m_expressions.emplace(_expr, expr);
+	return expr;
+}
+
+z3::expr Z3Interface::newZ3Expr(Expression const& _expr)
+{
+	if (_expr.arguments().empty() && m_constants.count(_expr.name()))
+		return m_constants.at(_expr.name());
 	z3::expr_vector arguments(m_context);
-	for (auto const& arg: _expr.arguments)
+	for (auto const& arg: _expr.arguments())
 		arguments.push_back(toZ3Expr(arg));
 
-	string const& n = _expr.name;
+	string const& n = _expr.name();
 	if (m_functions.count(n))
 		return m_functions.at(n)(arguments);
 	else if (m_constants.count(n))
@@ -23,6 +23,8 @@
 
 #include <z3++.h>
 
+#include <unordered_map>
+
 namespace dev
 {
 namespace solidity
@@ -45,16 +47,23 @@ public:
 	Expression newBool(std::string _name) override;
 
 	void addAssertion(Expression const& _expr) override;
-	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void setTimeout(unsigned _milliseconds) override;
+	std::pair<CheckResult, std::vector<std::string>> checkAssuming(
+		std::vector<Expression> const& _assumptions,
+		std::vector<Expression> const& _expressionsToEvaluate
+	) override;
 
 private:
+	/// @returns the translation of @a _expr, every distinct subexpression is translated only once.
 	z3::expr toZ3Expr(Expression const& _expr);
+	z3::expr newZ3Expr(Expression const& _expr);
 	z3::sort z3Sort(smt::Sort _sort);
 
 	z3::context m_context;
 	z3::solver m_solver;
 	std::map<std::string, z3::expr> m_constants;
 	std::map<std::string, z3::func_decl> m_functions;
+	std::unordered_map<Expression, z3::expr, Expression::IdentityHash, Expression::Identical> m_expressions;
 };
 
 }
@@ -47,6 +47,7 @@
 
 #include <libevmasm/Exceptions.h>
 
+#include <libdevcore/Parallel.h>
 #include <libdevcore/SwarmHash.h>
 #include <libdevcore/JSON.h>
 
@@ -54,10 +55,79 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <condition_variable>
+#include <mutex>
+
 using namespace std;
 using namespace dev;
 using namespace dev::solidity;
 
+namespace
+{
+
+/// Creates the annotations of all visited nodes, so that analysis passes running
+/// concurrently do not race on their lazy creation.
+class AnnotationAllocator: public ASTConstVisitor
+{
+protected:
+	bool visitNode(ASTNode const& _node) override
+	{
+		_node.annotation();
+		return true;
+	}
+};
+
+/// Runs @a _check(i, errorReporter) for all i in [0, _count) and appends the errors
+/// to @a _errors in the order of the indices.
+/// With a single job, the checks run one after another and a fatal error stops them.
+/// Otherwise, they run on up to @a _jobs threads, each with an error reporter of its own,
+/// and all of them run to completion. The first fatal error in the order of the indices
+/// then stops the merging and is rethrown, so the errors of the later checks are discarded
+/// and the result is the same as with a single job.
+/// @returns false if any check returned false.
+template <class Check>
+bool runChecks(size_t _count, unsigned _jobs, ErrorList& _errors, Check const& _check)
+{
+	if (_jobs <= 1)
+	{
+		bool noErrors = true;
+		ErrorReporter errorReporter(_errors);
+		for (size_t i = 0; i < _count; ++i)
+			if (!_check(i, errorReporter))
+				noErrors = false;
+		return noErrors;
+	}
+
+	vector<ErrorList> errors(_count);
+	// Not vector<bool>, its elements cannot be written concurrently.
+	vector<char> success(_count, false);
+	vector<char> fatal(_count, false);
+	parallelFor(_count, _jobs, [&](size_t _index)
+	{
+		ErrorReporter errorReporter(errors[_index]);
+		try
+		{
+			success[_index] = _check(_index, errorReporter);
+		}
+		catch (FatalError const&)
+		{
+			fatal[_index] = true;
+		}
+	});
+	bool noErrors = true;
+	for (size_t i = 0; i < _count; ++i)
+	{
+		_errors += errors[i];
+		if (fatal[i])
+			BOOST_THROW_EXCEPTION(FatalError());
+		if (!success[i])
+			noErrors = false;
+	}
+	return noErrors;
+}
+
+}
+
 void CompilerStack::setRemappings(vector<string> const& _remappings)
 {
 	vector<Remapping> remappings;
@@ -107,10 +177,15 @@ void CompilerStack::reset(bool _keepSources)
 }
 
 bool CompilerStack::addSource(string const& _name, string const& _content, bool _isLibrary)
+{
+	return addSource(_name, make_shared<string const>(_content), _isLibrary);
+}
+
+bool CompilerStack::addSource(string const& _name, shared_ptr<string const> _content, bool _isLibrary)
 {
 	bool existed = m_sources.count(_name) != 0;
 	reset(true);
-	m_sources[_name].scanner = make_shared<Scanner>(CharStream(_content), _name);
+	m_sources[_name].scanner = make_shared<Scanner>(CharStream(move(_content)), _name);
 	m_sources[_name].isLibrary = _isLibrary;
 	m_stackState = SourcesSet;
 	return existed;
@@ -130,26 +205,55 @@ bool CompilerStack::parse()
 	vector<string> sourcesToParse;
 	for (auto const& s: m_sources)
 		sourcesToParse.push_back(s.first);
-	for (size_t i = 0; i < sourcesToParse.size(); ++i)
+	// Sources are parsed in waves: all sources known so far are parsed concurrently,
+	// then the imports they reference are loaded and form the next wave.
+	// Errors and node IDs are arranged as if the sources were parsed one after another.
+	size_t lastID = 0;
+	for (size_t waveStart = 0; waveStart < sourcesToParse.size();)
 	{
-		string const& path = sourcesToParse[i];
-		Source& source = m_sources[path];
-		source.scanner->reset();
-		source.ast = Parser(m_errorReporter).parse(source.scanner);
-		if (!source.ast)
-			solAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
-		else
+		size_t const waveEnd = sourcesToParse.size();
+		vector<Source*> wave;
+		for (size_t i = waveStart; i < waveEnd; ++i)
+			wave.push_back(&m_sources[sourcesToParse[i]]);
+		vector<ErrorList> parserErrors(wave.size());
+		vector<size_t> nodeCounts(wave.size());
+		parallelFor(wave.size(), m_jobs, [&](size_t _index)
+		{
+			Source& source = *wave[_index];
+			ErrorReporter errorReporter(parserErrors[_index]);
+			ASTNode::resetID();
+			source.scanner->reset();
+			source.ast = Parser(errorReporter).parse(source.scanner);
+			nodeCounts[_index] = ASTNode::lastID();
+		});
+		for (size_t i = 0; i < wave.size(); ++i)
 		{
-			source.ast->annotation().path = path;
-			for (auto const& newSource: loadMissingSources(*source.ast, path))
+			string const& path = sourcesToParse[waveStart + i];
+			Source& source = *wave[i];
+			bool const parsingSuccessful = Error::containsOnlyWarnings(parserErrors[i]);
+			// This moves the errors out of parserErrors.
+			m_errorList += parserErrors[i];
+			if (!source.ast)
+				solAssert(!parsingSuccessful, "Parser returned null but did not report error.");
+			else
 			{
-				string const& newPath = newSource.first;
-				string const& newContents = newSource.second;
-				m_sources[newPath].scanner = make_shared<Scanner>(CharStream(newContents), newPath);
-				sourcesToParse.push_back(newPath);
+				// After a parser error the AST can contain null nodes. It is never analysed,
+				// so its IDs do not need to be shifted.
+				if (parsingSuccessful)
+					source.ast->shiftIDs(lastID);
+				source.ast->annotation().path = path;
+				for (auto& newSource: loadMissingSources(*source.ast, path))
+				{
+					string const& newPath = newSource.first;
+					m_sources[newPath].scanner = make_shared<Scanner>(CharStream(move(newSource.second)), newPath);
+					sourcesToParse.push_back(newPath);
+				}
 			}
+			lastID += nodeCounts[i];
 		}
+		waveStart = waveEnd;
 	}
+	ASTNode::resetID(lastID);
 	if (Error::containsOnlyWarnings(m_errorReporter.errors()))
 	{
 		m_stackState = ParsingSuccessful;
@@ -168,15 +272,19 @@ bool CompilerStack::analyze()
 	bool noErrors = true;
 
 	try {
-		SyntaxChecker syntaxChecker(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (!syntaxChecker.checkSyntax(*source->ast))
-				noErrors = false;
+		// Passes that only inspect a single source unit run concurrently for all
+		// source units if more than one job is requested.
+		if (!runChecks(m_sourceOrder.size(), m_jobs, m_errorList, [&](size_t _index, ErrorReporter& _errorReporter)
+		{
+			return SyntaxChecker(_errorReporter).checkSyntax(*m_sourceOrder[_index]->ast);
+		}))
+			noErrors = false;
 
-		DocStringAnalyser docStringAnalyser(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (!docStringAnalyser.analyseDocStrings(*source->ast))
-				noErrors = false;
+		if (!runChecks(m_sourceOrder.size(), m_jobs, m_errorList, [&](size_t _index, ErrorReporter& _errorReporter)
+		{
+			return DocStringAnalyser(_errorReporter).analyseDocStrings(*m_sourceOrder[_index]->ast);
+		}))
+			noErrors = false;
 
 		m_globalContext = make_shared<GlobalContext>();
 		NameAndTypeResolver resolver(m_globalContext->declarations(), m_scopes, m_errorReporter);
@@ -209,12 +317,17 @@ bool CompilerStack::analyze()
 						m_contracts[contract->fullyQualifiedName()].contract = contract;
 				}
 
-		TypeChecker typeChecker(m_evmVersion, m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-				if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
-					if (!typeChecker.checkTypeRequirements(*contract))
-						noErrors = false;
+		if (m_jobs > 1)
+		{
+			AnnotationAllocator annotationAllocator;
+			for (Source const* source: m_sourceOrder)
+				source->ast->accept(annotationAllocator);
+			for (Declaration const* declaration: m_globalContext->declarations())
+				declaration->annotation();
+		}
+
+		if (!typeCheck())
+			noErrors = false;
 
 		if (noErrors)
 		{
@@ -231,22 +344,18 @@ bool CompilerStack::analyze()
 				if (!cfg.constructFlow(*source->ast))
 					noErrors = false;
 
-			if (noErrors)
+			if (noErrors && !runChecks(m_sourceOrder.size(), m_jobs, m_errorList, [&](size_t _index, ErrorReporter& _errorReporter)
 			{
-				ControlFlowAnalyzer controlFlowAnalyzer(cfg, m_errorReporter);
-				for (Source const* source: m_sourceOrder)
-					if (!controlFlowAnalyzer.analyze(*source->ast))
-						noErrors = false;
-			}
+				return ControlFlowAnalyzer(cfg, _errorReporter).analyze(*m_sourceOrder[_index]->ast);
+			}))
+				noErrors = false;
 		}
 
-		if (noErrors)
+		if (noErrors && !runChecks(m_sourceOrder.size(), m_jobs, m_errorList, [&](size_t _index, ErrorReporter& _errorReporter)
 		{
-			StaticAnalyzer staticAnalyzer(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
-				if (!staticAnalyzer.analyze(*source->ast))
-					noErrors = false;
-		}
+			return StaticAnalyzer(_errorReporter).analyze(*m_sourceOrder[_index]->ast);
+		}))
+			noErrors = false;
 
 		if (noErrors)
 		{
@@ -260,9 +369,15 @@ bool CompilerStack::analyze()
 
 		if (noErrors)
 		{
-			SMTChecker smtChecker(m_errorReporter, m_smtQuery);
+			// Every function is checked by its own solver, concurrently if more than one job is requested.
+			vector<SMTChecker::Unit> smtUnits;
 			for (Source const* source: m_sourceOrder)
-				smtChecker.analyze(*source->ast);
+				smtUnits += SMTChecker::units(*source->ast);
+			runChecks(smtUnits.size(), m_jobs, m_errorList, [&](size_t _index, ErrorReporter& _errorReporter)
+			{
+				SMTChecker(_errorReporter, m_smtQuery, m_smtQueryCache, m_smtTimeout, m_smtIncremental).analyze(smtUnits[_index]);
+				return true;
+			});
 		}
 	}
 	catch(FatalError const&)
@@ -301,11 +416,12 @@ bool CompilerStack::compile()
 			return false;
 
 	map<ContractDefinition const*, eth::Assembly const*> compiledContracts;
+	auto abiFunctionsCache = make_shared<ABIFunctionsCache>(m_evmVersion);
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
 				if (isRequestedContract(*contract))
-					compileContract(*contract, compiledContracts);
+					compileContract(*contract, compiledContracts, abiFunctionsCache);
 	this->link();
 	m_stackState = CompilationSuccessful;
 	return true;
@@ -639,6 +755,69 @@ string CompilerStack::applyRemapping(string const& _path, string const& _context
 	return path;
 }
 
+bool CompilerStack::typeCheck()
+{
+	// Type checking a contract reads annotations that are written while type checking
+	// the contracts it can refer to, i.e. the contracts of the sources it imports.
+	// The sources are therefore split into groups which are checked in parallel,
+	// each waiting for the groups of the sources it imports. Sources in an import
+	// cycle are checked in the same group in m_sourceOrder, which gives the same
+	// result as checking all contracts in sequence.
+	map<Source const*, size_t> sourceIndex;
+	for (size_t i = 0; i < m_sourceOrder.size(); ++i)
+		sourceIndex[m_sourceOrder[i]] = i;
+	vector<vector<size_t>> imports(m_sourceOrder.size());
+	for (size_t i = 0; i < m_sourceOrder.size(); ++i)
+		for (ASTPointer<ASTNode> const& node: m_sourceOrder[i]->ast->nodes())
+			if (ImportDirective const* import = dynamic_cast<ImportDirective*>(node.get()))
+				imports[i].push_back(sourceIndex.at(&m_sources.at(import->annotation().absolutePath)));
+
+	// An import of a later source can only be part of a cycle, so the groups are
+	// contiguous ranges of m_sourceOrder that contain all such imports.
+	vector<size_t> groupStart;
+	vector<size_t> groupOf(m_sourceOrder.size());
+	size_t groupEnd = 0;
+	for (size_t i = 0; i < m_sourceOrder.size(); ++i)
+	{
+		if (i >= groupEnd)
+			groupStart.push_back(i);
+		groupOf[i] = groupStart.size() - 1;
+		groupEnd = max(groupEnd, i + 1);
+		for (size_t imported: imports[i])
+			groupEnd = max(groupEnd, imported + 1);
+	}
+	groupStart.push_back(m_sourceOrder.size());
+
+	mutex finishedMutex;
+	condition_variable groupFinished;
+	vector<char> finished(groupStart.size() - 1, false);
+	return runChecks(finished.size(), m_jobs, m_errorList, [&](size_t _group, ErrorReporter& _errorReporter)
+	{
+		ScopeGuard markFinished([&]()
+		{
+			lock_guard<mutex> lock(finishedMutex);
+			finished[_group] = true;
+			groupFinished.notify_all();
+		});
+		{
+			// Groups are started in ascending order, so all groups waited for are already running.
+			unique_lock<mutex> lock(finishedMutex);
+			for (size_t i = groupStart[_group]; i < groupStart[_group + 1]; ++i)
+				for (size_t imported: imports[i])
+					groupFinished.wait(lock, [&]() { return groupOf[imported] == _group || finished[groupOf[imported]]; });
+		}
+
+		bool noErrors = true;
+		TypeChecker typeChecker(m_evmVersion, _errorReporter);
+		for (size_t i = groupStart[_group]; i < groupStart[_group + 1]; ++i)
+			for (ASTPointer<ASTNode> const& node: m_sourceOrder[i]->ast->nodes())
+				if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
+					if (!typeChecker.checkTypeRequirements(*contract))
+						noErrors = false;
+		return noErrors;
+	});
+}
+
 void CompilerStack::resolveImports()
 {
 	// topological sorting (depth first search) of the import graph, cutting potential cycles
@@ -699,7 +878,8 @@ bool onlySafeExperimentalFeaturesActivated(set<ExperimentalFeature> const& featu
 
 void CompilerStack::compileContract(
 	ContractDefinition const& _contract,
-	map<ContractDefinition const*, eth::Assembly const*>& _compiledContracts
+	map<ContractDefinition const*, eth::Assembly const*>& _compiledContracts,
+	shared_ptr<ABIFunctionsCache> const& _abiFunctionsCache
 )
 {
 	if (
@@ -709,9 +889,9 @@ void CompilerStack::compileContract(
 	)
 		return;
 	for (auto const* dependency: _contract.annotation().contractDependencies)
-		compileContract(*dependency, _compiledContracts);
+		compileContract(*dependency, _compiledContracts, _abiFunctionsCache);
 
-	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_optimize, m_optimizeRuns);
+	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_optimize, m_optimizeRuns, _abiFunctionsCache);
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 	string metadata = createMetadata(compiledContract);
 	bytes cborEncodedHash =
@@ -734,6 +914,7 @@ void CompilerStack::compileContract(
 	solAssert(cborEncodedMetadata.size() <= 0xffff, "Metadata too large");
 	// 16-bit big endian length
 	cborEncodedMetadata += toCompactBigEndian(cborEncodedMetadata.size(), 2);
+	compiler->setReleaseStatementMemory(m_optimize);
 	compiler->compileContract(_contract, _compiledContracts, cborEncodedMetadata);
 	compiledContract.compiler = compiler;
 
@@ -770,7 +951,7 @@ void CompilerStack::compileContract(
 	{
 		if (!_contract.isLibrary())
 		{
-			Compiler cloneCompiler(m_evmVersion, m_optimize, m_optimizeRuns);
+			Compiler cloneCompiler(m_evmVersion, m_optimize, m_optimizeRuns, _abiFunctionsCache);
 			cloneCompiler.compileClone(_contract, _compiledContracts);
 			compiledContract.cloneObject = cloneCompiler.assembledObject();
 		}
@@ -866,7 +1047,7 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 		{
 			meta["sources"][s.first]["urls"] = Json::arrayValue;
 			meta["sources"][s.first]["urls"].append(
-				"bzzr://" + toHex(dev::swarmHash(s.second.scanner->source()).asBytes())
+				"bzzr://" + toHex(dev::swarmHash(bytesConstRef(s.second.scanner->source()), m_jobs).asBytes())
 			);
 		}
 	}
@@ -986,7 +1167,7 @@ Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 		return Json::Value();
 
 	using Gas = GasEstimator::GasConsumption;
-	GasEstimator gasEstimator(m_evmVersion);
+	GasEstimator gasEstimator(m_evmVersion, m_jobs);
 	Json::Value output(Json::objectValue);
 
 	if (eth::AssemblyItems const* items = assemblyItems(_contractName))
@@ -1009,11 +1190,11 @@ Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 		/// External functions
 		ContractDefinition const& contract = contractDefinition(_contractName);
 		Json::Value externalFunctions(Json::objectValue);
+		vector<string> signatures;
 		for (auto it: contract.interfaceFunctions())
-		{
-			string sig = it.second->externalSignature();
-			externalFunctions[sig] = gasToJson(gasEstimator.functionalEstimation(*items, sig));
-		}
+			signatures.push_back(it.second->externalSignature());
+		for (auto const& it: gasEstimator.functionalEstimations(*items, signatures))
+			externalFunctions[it.first] = gasToJson(it.second);
 
 		if (contract.fallbackFunction())
 			/// This needs to be set to an invalid signature in order to trigger the fallback,
@@ -1025,27 +1206,33 @@ Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 			output["external"] = externalFunctions;
 
 		/// Internal functions
-		Json::Value internalFunctions(Json::objectValue);
+		vector<FunctionDefinition const*> functions;
 		for (auto const& it: contract.definedFunctions())
-		{
 			/// Exclude externally visible functions, constructor and the fallback function
-			if (it->isPartOfExternalInterface() || it->isConstructor() || it->isFallback())
-				continue;
+			if (!it->isPartOfExternalInterface() && !it->isConstructor() && !it->isFallback())
+				functions.push_back(it);
 
-			size_t entry = functionEntryPoint(_contractName, *it);
-			GasEstimator::GasConsumption gas = GasEstimator::GasConsumption::infinite();
+		/// The functions are estimated independently of each other, possibly concurrently.
+		vector<Gas> internalGas(functions.size(), Gas::infinite());
+		parallelFor(functions.size(), m_jobs, [&](size_t _index)
+		{
+			size_t entry = functionEntryPoint(_contractName, *functions[_index]);
 			if (entry > 0)
-				gas = gasEstimator.functionalEstimation(*items, entry, *it);
+				internalGas[_index] = gasEstimator.functionalEstimation(*items, entry, *functions[_index]);
+		});
 
+		Json::Value internalFunctions(Json::objectValue);
+		for (size_t i = 0; i < functions.size(); ++i)
+		{
 			/// TODO: This could move into a method shared with externalSignature()
-			FunctionType type(*it);
-			string sig = it->name() + "(";
+			FunctionType type(*functions[i]);
+			string sig = functions[i]->name() + "(";
 			auto paramTypes = type.parameterTypes();
 			for (auto it = paramTypes.begin(); it != paramTypes.end(); ++it)
 				sig += (*it)->toString() + (it + 1 == paramTypes.end() ? "" : ",");
 			sig += ")";
 
-			internalFunctions[sig] = gasToJson(gas);
+			internalFunctions[sig] = gasToJson(internalGas[i]);
 		}
 
 		if (!internalFunctions.empty())
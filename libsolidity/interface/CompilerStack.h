@@ -42,6 +42,7 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <unordered_map>
 #include <functional>
 
 namespace dev
@@ -68,6 +69,11 @@ class GlobalContext;
 class Natspec;
 class Error;
 class DeclarationContainer;
+struct ABIFunctionsCache;
+namespace smt
+{
+class SMTQueryCache;
+}
 
 /**
  * Easy to use and self-contained Solidity compiler with as few header dependencies as possible.
@@ -101,7 +107,8 @@ public:
 
 	/// Resets the compiler to a state where the sources are not parsed or even removed.
 	/// Sets the state to SourcesSet if @a _keepSources is true, otherwise to Empty.
-	/// All settings, with the exception of remappings, are reset.
+	/// All settings, with the exception of remappings, the number of jobs, the SMT query cache,
+	/// the SMT query timeout and the incremental mode of the SMT checker, are reset.
 	void reset(bool _keepSources = false);
 
 	/// Sets path remappings in the format "context:prefix=target"
@@ -124,6 +131,30 @@ public:
 
 	void setEVMVersion(EVMVersion _version = EVMVersion{});
 
+	/// Sets the maximal number of threads used to parse and analyse source units
+	/// and to check functions with the SMT checker and estimate their gas costs
+	/// concurrently. The result does not
+	/// depend on this setting, in particular not the node IDs and the order of errors.
+	/// The number of jobs is not changed by reset.
+	void setJobs(unsigned _jobs) { m_jobs = std::max(_jobs, 1u); }
+	unsigned jobs() const { return m_jobs; }
+
+	/// Sets the cache for the results of the queries of the SMT checker.
+	/// The cache is not cleared by reset and can be shared across compilations.
+	void setSMTQueryCache(std::shared_ptr<smt::SMTQueryCache> _cache) { m_smtQueryCache = std::move(_cache); }
+
+	/// Limits the time of each query of the SMT checker to @a _milliseconds.
+	/// Zero means no limit. Queries that reach the limit are treated as unknown.
+	/// The timeout is not changed by reset.
+	void setSMTTimeout(unsigned _milliseconds) { m_smtTimeout = _milliseconds; }
+	unsigned smtTimeout() const { return m_smtTimeout; }
+
+	/// Lets the SMT checker check its targets under assumption literals instead of
+	/// asserting them between push and pop (see SMTChecker::SMTChecker).
+	/// The mode is not changed by reset.
+	void setSMTIncremental(bool _incremental) { m_smtIncremental = _incremental; }
+	bool smtIncremental() const { return m_smtIncremental; }
+
 	/// Sets the list of requested contract names. If empty, no filtering is performed and every contract
 	/// found in the supplied sources is compiled. Names are cleared iff @a _contractNames is missing.
 	void setRequestedContractNames(std::set<std::string> const& _contractNames = std::set<std::string>{})
@@ -137,6 +168,8 @@ public:
 	/// Adds a source object (e.g. file) to the parser. After this, parse has to be called again.
 	/// @returns true if a source object by the name already existed and was replaced.
 	bool addSource(std::string const& _name, std::string const& _content, bool _isLibrary = false);
+	/// Adds a source object whose content is shared with the caller instead of being copied.
+	bool addSource(std::string const& _name, std::shared_ptr<std::string const> _content, bool _isLibrary = false);
 
 	/// Parses all source units that were added
 	/// @returns false on error.
@@ -272,6 +305,9 @@ private:
 	StringMap loadMissingSources(SourceUnit const& _ast, std::string const& _path);
 	std::string applyRemapping(std::string const& _path, std::string const& _context);
 	void resolveImports();
+	/// Runs the type checker on all contracts, concurrently if more than one job is requested.
+	/// @returns false on error.
+	bool typeCheck();
 	/// @returns the absolute path corresponding to @a _path relative to @a _reference.
 	std::string absolutePath(std::string const& _path, std::string const& _reference) const;
 	/// Helper function to return path converted strings.
@@ -281,9 +317,11 @@ private:
 	bool isRequestedContract(ContractDefinition const& _contract) const;
 
 	/// Compile a single contract and put the result in @a _compiledContracts.
+	/// @param _abiFunctionsCache cache of ABI routines shared by all contracts of the compilation.
 	void compileContract(
 		ContractDefinition const& _contract,
-		std::map<ContractDefinition const*, eth::Assembly const*>& _compiledContracts
+		std::map<ContractDefinition const*, eth::Assembly const*>& _compiledContracts,
+		std::shared_ptr<ABIFunctionsCache> const& _abiFunctionsCache
 	);
 	void link();
 
@@ -316,8 +354,12 @@ private:
 
 	ReadCallback::Callback m_readFile;
 	ReadCallback::Callback m_smtQuery;
+	std::shared_ptr<smt::SMTQueryCache> m_smtQueryCache;
+	unsigned m_smtTimeout = 0;
+	bool m_smtIncremental = false;
 	bool m_optimize = false;
 	unsigned m_optimizeRuns = 200;
+	unsigned m_jobs = 1;
 	EVMVersion m_evmVersion;
 	std::set<std::string> m_requestedContractNames;
 	std::map<std::string, h160> m_libraries;
@@ -326,7 +368,7 @@ private:
 	std::vector<Remapping> m_remappings;
 	std::map<std::string const, Source> m_sources;
 	std::shared_ptr<GlobalContext> m_globalContext;
-	std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>> m_scopes;
+	std::unordered_map<ASTNode const*, std::shared_ptr<DeclarationContainer>> m_scopes;
 	std::vector<Source const*> m_sourceOrder;
 	std::map<std::string const, Contract> m_contracts;
 	ErrorList m_errorList;
@@ -24,6 +24,7 @@
 #include <map>
 #include <functional>
 #include <memory>
+#include <libdevcore/Parallel.h>
 #include <libdevcore/SHA3.h>
 #include <libevmasm/ControlFlowGraph.h>
 #include <libevmasm/KnownState.h>
@@ -164,6 +165,58 @@ GasEstimator::GasConsumption GasEstimator::functionalEstimation(
 	return meter.estimateMax(0, state);
 }
 
+map<string, GasEstimator::GasConsumption> GasEstimator::functionalEstimations(
+	AssemblyItems const& _items,
+	vector<string> const& _signatures
+) const
+{
+	auto state = make_shared<KnownState>();
+	ExpressionClasses& classes = state->expressionClasses();
+	// lt(calldatasize(), 4) equals to 0 (ignore the shortcut for fallback functions)
+	classes.forceEqual(
+		classes.find(u256(0)),
+		Instruction::LT,
+		ExpressionClasses::Ids{classes.find(Instruction::CALLDATASIZE), classes.find(u256(4))}
+	);
+
+	// The selector compares the function hash to the hash of each function and jumps to it
+	// if they are equal. Stop at these jumps and continue from there for each function.
+	PathGasMeter meter(_items, m_evmVersion);
+	map<u256, GasPath> entryPaths;
+	for (GasPathBranch& branch: meter.unknownBranches(0, state))
+		if (u256 const* hashValue = comparedConstant(classes, branch.condition))
+			if (!entryPaths.count(*hashValue))
+				entryPaths[*hashValue] = move(branch.path);
+
+	// The estimation adds to the expression classes, so every job works on its own copy.
+	// The functions are distributed to the jobs in a fixed way.
+	size_t jobs = max<size_t>(min<size_t>(m_jobs, _signatures.size()), 1);
+	vector<GasConsumption> results(_signatures.size());
+	parallelFor(jobs, m_jobs, [&](size_t _job)
+	{
+		auto jobClasses = make_shared<ExpressionClasses>(classes);
+		PathGasMeter jobMeter(meter);
+		for (size_t i = _job; i < _signatures.size(); i += jobs)
+		{
+			u256 hashValue(FixedHash<4>::Arith(FixedHash<4>(dev::keccak256(_signatures[i]))));
+			auto entry = entryPaths.find(hashValue);
+			if (entry == entryPaths.end())
+				results[i] = functionalEstimation(_items, _signatures[i]);
+			else
+			{
+				GasPath path = entry->second;
+				path.state = path.state->copy(jobClasses);
+				results[i] = jobMeter.estimateMax(path);
+			}
+		}
+	});
+
+	map<string, GasConsumption> gas;
+	for (size_t i = 0; i < _signatures.size(); ++i)
+		gas[_signatures[i]] = results[i];
+	return gas;
+}
+
 GasEstimator::GasConsumption GasEstimator::functionalEstimation(
 	AssemblyItems const& _items,
 	size_t const& _offset,
@@ -186,6 +239,19 @@ GasEstimator::GasConsumption GasEstimator::functionalEstimation(
 	return PathGasMeter(_items, m_evmVersion).estimateMax(_offset, state);
 }
 
+u256 const* GasEstimator::comparedConstant(ExpressionClasses& _classes, ExpressionClasses::Id _condition)
+{
+	ExpressionClasses::Expression const& expression = _classes.representative(_condition);
+	if (!expression.item || *expression.item != AssemblyItem(Instruction::EQ))
+		return nullptr;
+	solAssert(expression.arguments.size() == 2, "");
+	u256 const* first = _classes.knownConstant(expression.arguments[0]);
+	u256 const* second = _classes.knownConstant(expression.arguments[1]);
+	if (!first == !second)
+		return nullptr;
+	return first ? first : second;
+}
+
 set<ASTNode const*> GasEstimator::finestNodesAtLocation(
 	vector<ASTNode const*> const& _roots
 )
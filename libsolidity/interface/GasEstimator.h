@@ -26,6 +26,7 @@
 
 #include <libevmasm/GasMeter.h>
 #include <libevmasm/Assembly.h>
+#include <libevmasm/ExpressionClasses.h>
 
 #include <vector>
 #include <map>
@@ -47,7 +48,9 @@ public:
 	using ASTGasConsumptionSelfAccumulated =
 		std::map<ASTNode const*, std::array<GasConsumption, 2>>;
 
-	explicit GasEstimator(EVMVersion _evmVersion): m_evmVersion(_evmVersion) {}
+	/// @param _jobs maximum number of threads used to estimate multiple functions.
+	explicit GasEstimator(EVMVersion _evmVersion, unsigned _jobs = 1):
+		m_evmVersion(_evmVersion), m_jobs(_jobs) {}
 
 	/// Estimates the gas consumption for every assembly item in the given assembly and stores
 	/// it by source location.
@@ -72,6 +75,15 @@ public:
 		std::string const& _signature = ""
 	) const;
 
+	/// @returns the estimated gas consumption by the (public or external) functions with the
+	/// given signatures. The function selector is only analysed once and each function is
+	/// estimated starting from the state in which the selector jumps to it.
+	/// The functions are estimated concurrently if more than one job is allowed.
+	std::map<std::string, GasConsumption> functionalEstimations(
+		eth::AssemblyItems const& _items,
+		std::vector<std::string> const& _signatures
+	) const;
+
 	/// @returns the estimated gas consumption by the given function which starts at the given
 	/// offset into the list of assembly items.
 	/// @note this does not work correctly for recursive functions.
@@ -84,7 +96,11 @@ public:
 private:
 	/// @returns the set of AST nodes which are the finest nodes at their location.
 	static std::set<ASTNode const*> finestNodesAtLocation(std::vector<ASTNode const*> const& _roots);
+	/// @returns the constant that is compared to a non-constant value for equality by
+	/// @a _condition or nullptr if @a _condition is not such a comparison.
+	static u256 const* comparedConstant(eth::ExpressionClasses& _classes, eth::ExpressionClasses::Id _condition);
 	EVMVersion m_evmVersion;
+	unsigned m_jobs = 1;
 };
 
 }
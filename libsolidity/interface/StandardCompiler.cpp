@@ -24,6 +24,7 @@
 #include <libsolidity/interface/SourceReferenceFormatter.h>
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <libevmasm/Instruction.h>
+#include <libdevcore/CBOR.h>
 #include <libdevcore/JSON.h>
 #include <libdevcore/SHA3.h>
 
@@ -63,6 +64,32 @@ Json::Value formatFatalError(string const& _type, string const& _message)
 	return output;
 }
 
+/// @returns the output for an exception that escaped the compilation.
+/// Has to be called from within a catch block.
+Json::Value formatInternalException()
+{
+	try
+	{
+		throw;
+	}
+	catch (Json::LogicError const& _exception)
+	{
+		return formatFatalError("InternalCompilerError", string("JSON logic exception: ") + _exception.what());
+	}
+	catch (Json::RuntimeError const& _exception)
+	{
+		return formatFatalError("InternalCompilerError", string("JSON runtime exception: ") + _exception.what());
+	}
+	catch (Exception const& _exception)
+	{
+		return formatFatalError("InternalCompilerError", "Internal exception in StandardCompiler::compileInternal: " + boost::diagnostic_information(_exception));
+	}
+	catch (...)
+	{
+		return formatFatalError("InternalCompilerError", "Internal exception in StandardCompiler::compileInternal");
+	}
+}
+
 Json::Value formatErrorWithException(
 	Exception const& _exception,
 	bool const& _warning,
@@ -225,9 +252,23 @@ Json::Value collectEVMObject(eth::LinkerObject const& _object, string const* _so
 	return output;
 }
 
+/// @returns true if the output for @a _input is requested in CBOR instead of JSON.
+bool cborOutputRequested(Json::Value const& _input)
+{
+	if (!_input.isObject() || !_input["settings"].isObject())
+		return false;
+	return _input["settings"]["outputFormat"] == "cbor";
+}
+
+string cborString(Json::Value const& _output)
+{
+	bytes encoded = cborEncode(_output);
+	return string(encoded.begin(), encoded.end());
+}
+
 }
 
-Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
+Json::Value StandardCompiler::compileInternal(Json::Value const& _input, Json::Value& _errors)
 {
 	m_compilerStack.reset(false);
 
@@ -245,7 +286,7 @@ Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
 	if (sources.empty())
 		return formatFatalError("JSONError", "No input sources specified.");
 
-	Json::Value errors = Json::arrayValue;
+	_errors = Json::arrayValue;
 
 	for (auto const& sourceName: sources.getMemberNames())
 	{
@@ -261,14 +302,14 @@ Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
 		{
 			string content = sources[sourceName]["content"].asString();
 			if (!hash.empty() && !hashMatchesContent(hash, content))
-				errors.append(formatError(
+				_errors.append(formatError(
 					false,
 					"IOError",
 					"general",
 					"Mismatch between content and supplied hash for \"" + sourceName + "\""
 				));
 			else
-				m_compilerStack.addSource(sourceName, content);
+				m_compilerStack.addSource(sourceName, make_shared<string const>(move(content)));
 		}
 		else if (sources[sourceName]["urls"].isArray())
 		{
@@ -284,7 +325,7 @@ Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
 				if (result.success)
 				{
 					if (!hash.empty() && !hashMatchesContent(hash, result.responseOrErrorMessage))
-						errors.append(formatError(
+						_errors.append(formatError(
 							false,
 							"IOError",
 							"general",
@@ -292,7 +333,7 @@ Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
 						));
 					else
 					{
-						m_compilerStack.addSource(sourceName, result.responseOrErrorMessage);
+						m_compilerStack.addSource(sourceName, make_shared<string const>(move(result.responseOrErrorMessage)));
 						found = true;
 						break;
 					}
@@ -304,7 +345,7 @@ Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
 			for (auto const& failure: failures)
 			{
 				/// If the import succeeded, let mark all the others as warnings, otherwise all of them are errors.
-				errors.append(formatError(
+				_errors.append(formatError(
 					found ? true : false,
 					"IOError",
 					"general",
@@ -326,6 +367,10 @@ Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
 		m_compilerStack.setEVMVersion(*version);
 	}
 
+	Json::Value const& outputFormat = settings.get("outputFormat", "json");
+	if (outputFormat != "json" && outputFormat != "cbor")
+		return formatFatalError("JSONError", "Invalid output format requested.");
+
 	vector<string> remappings;
 	for (auto const& remapping: settings.get("remappings", Json::Value()))
 		remappings.push_back(remapping.asString());
@@ -393,7 +438,7 @@ Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
 		{
 			Error const& err = dynamic_cast<Error const&>(*error);
 
-			errors.append(formatErrorWithException(
+			_errors.append(formatErrorWithException(
 				*error,
 				err.type() == Error::Type::Warning,
 				err.typeName(),
@@ -406,7 +451,7 @@ Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
 	/// This is only thrown in a very few locations.
 	catch (Error const& _error)
 	{
-		errors.append(formatErrorWithException(
+		_errors.append(formatErrorWithException(
 			_error,
 			false,
 			_error.typeName(),
@@ -418,7 +463,7 @@ Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
 	/// This should not be leaked from compile().
 	catch (FatalError const& _exception)
 	{
-		errors.append(formatError(
+		_errors.append(formatError(
 			false,
 			"FatalError",
 			"general",
@@ -427,7 +472,7 @@ Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
 	}
 	catch (CompilerError const& _exception)
 	{
-		errors.append(formatErrorWithException(
+		_errors.append(formatErrorWithException(
 			_exception,
 			false,
 			"CompilerError",
@@ -438,7 +483,7 @@ Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
 	}
 	catch (InternalCompilerError const& _exception)
 	{
-		errors.append(formatErrorWithException(
+		_errors.append(formatErrorWithException(
 			_exception,
 			false,
 			"InternalCompilerError",
@@ -449,7 +494,7 @@ Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
 	}
 	catch (UnimplementedFeatureError const& _exception)
 	{
-		errors.append(formatErrorWithException(
+		_errors.append(formatErrorWithException(
 			_exception,
 			false,
 			"UnimplementedFeatureError",
@@ -460,7 +505,7 @@ Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
 	}
 	catch (Exception const& _exception)
 	{
-		errors.append(formatError(
+		_errors.append(formatError(
 			false,
 			"Exception",
 			"general",
@@ -469,7 +514,7 @@ Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
 	}
 	catch (...)
 	{
-		errors.append(formatError(
+		_errors.append(formatError(
 			false,
 			"Exception",
 			"general",
@@ -477,117 +522,182 @@ Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
 		));
 	}
 
-	bool const analysisSuccess = m_compilerStack.state() >= CompilerStack::State::AnalysisSuccessful;
 	bool const compilationSuccess = m_compilerStack.state() == CompilerStack::State::CompilationSuccessful;
 
 	/// Inconsistent state - stop here to receive error reports from users
-	if (!compilationSuccess && (errors.size() == 0))
+	if (!compilationSuccess && (_errors.size() == 0))
 		return formatFatalError("InternalCompilerError", "No error reported, but compilation failed.");
 
-	Json::Value output = Json::objectValue;
+	return Json::Value();
+}
+
+template <class Writer>
+void StandardCompiler::writeOutput(Json::Value const& _input, Json::Value const& _errors, Writer& _writer)
+{
+	Json::Value outputSelection = _input.get("settings", Json::Value()).get("outputSelection", Json::Value());
+	bool const analysisSuccess = m_compilerStack.state() >= CompilerStack::State::AnalysisSuccessful;
+	bool const compilationSuccess = m_compilerStack.state() == CompilerStack::State::CompilationSuccessful;
+
+	// Members are written in the order of their names, which is the order Json::Value uses,
+	// except for the errors: They come last, so that an internal error that occurs while
+	// streaming the output can still be added to them (see compile(string, ostream)).
+	_writer.beginObject();
+
+	// Contract names are grouped by file, since "file:name" does not sort by file
+	// if file names are prefixes of each other.
+	map<string, map<string, string>> contractsByFile;
+	for (string const& contractName: compilationSuccess ? m_compilerStack.contractNames() : vector<string>())
+	{
+		size_t colon = contractName.rfind(':');
+		solAssert(colon != string::npos, "");
+		contractsByFile[contractName.substr(0, colon)][contractName.substr(colon + 1)] = contractName;
+	}
 
-	if (errors.size() > 0)
-		output["errors"] = errors;
+	_writer.member("contracts");
+	_writer.beginObject();
+	for (auto const& fileAndContracts: contractsByFile)
+	{
+		string const& file = fileAndContracts.first;
+		_writer.member(file);
+		_writer.beginObject();
+		for (auto const& nameAndContract: fileAndContracts.second)
+		{
+			string const& name = nameAndContract.first;
+			string const& contractName = nameAndContract.second;
+			_writer.member(name);
+			_writer.beginObject();
 
-	output["sources"] = Json::objectValue;
+			// ABI, documentation and metadata
+			if (isArtifactRequested(outputSelection, file, name, "abi"))
+			{
+				_writer.member("abi");
+				_writer.value(m_compilerStack.contractABI(contractName));
+			}
+			if (isArtifactRequested(outputSelection, file, name, "devdoc"))
+			{
+				_writer.member("devdoc");
+				_writer.value(m_compilerStack.natspecDev(contractName));
+			}
+
+			// EVM
+			_writer.member("evm");
+			_writer.beginObject();
+			// @TODO: add ir
+			if (isArtifactRequested(outputSelection, file, name, "evm.assembly"))
+			{
+				_writer.member("assembly");
+				_writer.value(m_compilerStack.assemblyString(contractName, createSourceList(_input)));
+			}
+			if (isArtifactRequested(
+				outputSelection,
+				file,
+				name,
+				{ "evm.bytecode", "evm.bytecode.object", "evm.bytecode.opcodes", "evm.bytecode.sourceMap", "evm.bytecode.linkReferences" }
+			))
+			{
+				_writer.member("bytecode");
+				_writer.value(collectEVMObject(
+					m_compilerStack.object(contractName),
+					m_compilerStack.sourceMapping(contractName)
+				));
+			}
+			if (isArtifactRequested(
+				outputSelection,
+				file,
+				name,
+				{ "evm.deployedBytecode", "evm.deployedBytecode.object", "evm.deployedBytecode.opcodes", "evm.deployedBytecode.sourceMap", "evm.deployedBytecode.linkReferences" }
+			))
+			{
+				_writer.member("deployedBytecode");
+				_writer.value(collectEVMObject(
+					m_compilerStack.runtimeObject(contractName),
+					m_compilerStack.runtimeSourceMapping(contractName)
+				));
+			}
+			if (isArtifactRequested(outputSelection, file, name, "evm.gasEstimates"))
+			{
+				_writer.member("gasEstimates");
+				_writer.value(m_compilerStack.gasEstimates(contractName));
+			}
+			if (isArtifactRequested(outputSelection, file, name, "evm.legacyAssembly"))
+			{
+				_writer.member("legacyAssembly");
+				_writer.value(m_compilerStack.assemblyJSON(contractName, createSourceList(_input)));
+			}
+			if (isArtifactRequested(outputSelection, file, name, "evm.methodIdentifiers"))
+			{
+				_writer.member("methodIdentifiers");
+				_writer.value(m_compilerStack.methodIdentifiers(contractName));
+			}
+			_writer.endObject();
+
+			if (isArtifactRequested(outputSelection, file, name, "metadata"))
+			{
+				_writer.member("metadata");
+				_writer.value(m_compilerStack.metadata(contractName));
+			}
+			if (isArtifactRequested(outputSelection, file, name, "userdoc"))
+			{
+				_writer.member("userdoc");
+				_writer.value(m_compilerStack.natspecUser(contractName));
+			}
+
+			_writer.endObject();
+		}
+		_writer.endObject();
+	}
+	_writer.endObject();
+
+	_writer.member("sources");
+	_writer.beginObject();
 	unsigned sourceIndex = 0;
 	for (string const& sourceName: analysisSuccess ? m_compilerStack.sourceNames() : vector<string>())
 	{
-		Json::Value sourceResult = Json::objectValue;
-		sourceResult["id"] = sourceIndex++;
+		_writer.member(sourceName);
+		_writer.beginObject();
 		if (isArtifactRequested(outputSelection, sourceName, "", "ast"))
-			sourceResult["ast"] = ASTJsonConverter(false, m_compilerStack.sourceIndices()).toJson(m_compilerStack.ast(sourceName));
+		{
+			_writer.member("ast");
+			ASTJsonConverter(false, m_compilerStack.sourceIndices()).write(_writer, m_compilerStack.ast(sourceName));
+		}
+		_writer.member("id");
+		_writer.value(sourceIndex++);
 		if (isArtifactRequested(outputSelection, sourceName, "", "legacyAST"))
-			sourceResult["legacyAST"] = ASTJsonConverter(true, m_compilerStack.sourceIndices()).toJson(m_compilerStack.ast(sourceName));
-		output["sources"][sourceName] = sourceResult;
+		{
+			_writer.member("legacyAST");
+			ASTJsonConverter(true, m_compilerStack.sourceIndices()).write(_writer, m_compilerStack.ast(sourceName));
+		}
+		_writer.endObject();
 	}
+	_writer.endObject();
 
-	Json::Value contractsOutput = Json::objectValue;
-	for (string const& contractName: compilationSuccess ? m_compilerStack.contractNames() : vector<string>())
+	if (_errors.size() > 0)
 	{
-		size_t colon = contractName.rfind(':');
-		solAssert(colon != string::npos, "");
-		string file = contractName.substr(0, colon);
-		string name = contractName.substr(colon + 1);
-
-		// ABI, documentation and metadata
-		Json::Value contractData(Json::objectValue);
-		if (isArtifactRequested(outputSelection, file, name, "abi"))
-			contractData["abi"] = m_compilerStack.contractABI(contractName);
-		if (isArtifactRequested(outputSelection, file, name, "metadata"))
-			contractData["metadata"] = m_compilerStack.metadata(contractName);
-		if (isArtifactRequested(outputSelection, file, name, "userdoc"))
-			contractData["userdoc"] = m_compilerStack.natspecUser(contractName);
-		if (isArtifactRequested(outputSelection, file, name, "devdoc"))
-			contractData["devdoc"] = m_compilerStack.natspecDev(contractName);
-
-		// EVM
-		Json::Value evmData(Json::objectValue);
-		// @TODO: add ir
-		if (isArtifactRequested(outputSelection, file, name, "evm.assembly"))
-			evmData["assembly"] = m_compilerStack.assemblyString(contractName, createSourceList(_input));
-		if (isArtifactRequested(outputSelection, file, name, "evm.legacyAssembly"))
-			evmData["legacyAssembly"] = m_compilerStack.assemblyJSON(contractName, createSourceList(_input));
-		if (isArtifactRequested(outputSelection, file, name, "evm.methodIdentifiers"))
-			evmData["methodIdentifiers"] = m_compilerStack.methodIdentifiers(contractName);
-		if (isArtifactRequested(outputSelection, file, name, "evm.gasEstimates"))
-			evmData["gasEstimates"] = m_compilerStack.gasEstimates(contractName);
-
-		if (isArtifactRequested(
-			outputSelection,
-			file,
-			name,
-			{ "evm.bytecode", "evm.bytecode.object", "evm.bytecode.opcodes", "evm.bytecode.sourceMap", "evm.bytecode.linkReferences" }
-		))
-			evmData["bytecode"] = collectEVMObject(
-				m_compilerStack.object(contractName),
-				m_compilerStack.sourceMapping(contractName)
-			);
-
-		if (isArtifactRequested(
-			outputSelection,
-			file,
-			name,
-			{ "evm.deployedBytecode", "evm.deployedBytecode.object", "evm.deployedBytecode.opcodes", "evm.deployedBytecode.sourceMap", "evm.deployedBytecode.linkReferences" }
-		))
-			evmData["deployedBytecode"] = collectEVMObject(
-				m_compilerStack.runtimeObject(contractName),
-				m_compilerStack.runtimeSourceMapping(contractName)
-			);
-
-		contractData["evm"] = evmData;
-
-		if (!contractsOutput.isMember(file))
-			contractsOutput[file] = Json::objectValue;
-
-		contractsOutput[file][name] = contractData;
-	}
-	output["contracts"] = contractsOutput;
+		_writer.member("errors");
+		_writer.beginArray();
+		for (Json::Value const& error: _errors)
+			_writer.value(error);
+		_writer.endArray();
+	}
 
-	return output;
+	_writer.endObject();
 }
 
 Json::Value StandardCompiler::compile(Json::Value const& _input)
 {
 	try
 	{
-		return compileInternal(_input);
-	}
-	catch (Json::LogicError const& _exception)
-	{
-		return formatFatalError("InternalCompilerError", string("JSON logic exception: ") + _exception.what());
-	}
-	catch (Json::RuntimeError const& _exception)
-	{
-		return formatFatalError("InternalCompilerError", string("JSON runtime exception: ") + _exception.what());
-	}
-	catch (Exception const& _exception)
-	{
-		return formatFatalError("InternalCompilerError", "Internal exception in StandardCompiler::compileInternal: " + boost::diagnostic_information(_exception));
+		Json::Value errors;
+		Json::Value fatalError = compileInternal(_input, errors);
+		if (!fatalError.isNull())
+			return fatalError;
+		JsonTreeWriter writer;
+		writeOutput(_input, errors, writer);
+		return writer.result();
 	}
 	catch (...)
 	{
-		return formatFatalError("InternalCompilerError", "Internal exception in StandardCompiler::compileInternal");
+		return formatInternalException();
 	}
 }
 
@@ -611,6 +721,8 @@ string StandardCompiler::compile(string const& _input)
 
 	try
 	{
+		if (cborOutputRequested(input))
+			return cborString(output);
 		return jsonCompactPrint(output);
 	}
 	catch(...)
@@ -618,3 +730,67 @@ string StandardCompiler::compile(string const& _input)
 		return "{\"errors\":\"[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
 	}
 }
+
+void StandardCompiler::compile(string const& _input, ostream& _output)
+{
+	Json::Value input;
+	string errors;
+	try
+	{
+		if (!jsonParseStrict(_input, input, &errors))
+		{
+			_output << jsonCompactPrint(formatFatalError("JSONError", errors));
+			return;
+		}
+	}
+	catch(...)
+	{
+		_output << "{\"errors\":\"[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		return;
+	}
+
+	if (cborOutputRequested(input))
+	{
+		// The length of CBOR maps and arrays precedes their elements, so the output is built first.
+		_output << cborString(compile(input));
+		return;
+	}
+
+	JsonStreamWriter writer(_output);
+	Json::Value outputErrors;
+	try
+	{
+		Json::Value fatalError = compileInternal(input, outputErrors);
+		if (!fatalError.isNull())
+			writer.value(fatalError);
+		else
+			writeOutput(input, outputErrors, writer);
+	}
+	catch (...)
+	{
+		if (writer.empty())
+			writer.value(formatInternalException());
+		else if (writer.depth() > 0)
+		{
+			// The output is ended early. The errors are written last, so the error can be
+			// added to them: If they have been started, it is appended to the open array,
+			// otherwise all errors are written now. If the array has already been closed,
+			// the error cannot be reported any more.
+			Json::Value internalError = formatInternalException();
+			if (writer.lastMember(0) != "errors")
+			{
+				writer.endAll(1);
+				writer.member("errors");
+				writer.beginArray();
+				for (Json::Value const& error: outputErrors)
+					writer.value(error);
+			}
+			else if (writer.depth() > 2)
+				writer.endAll(2);
+			if (writer.depth() == 2)
+				for (Json::Value const& error: internalError["errors"])
+					writer.value(error);
+			writer.endAll();
+		}
+	}
+}
@@ -50,10 +50,36 @@ public:
 	Json::Value compile(Json::Value const& _input);
 	/// Parses input as JSON and peforms the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
+	/// If the setting "outputFormat" is "cbor", the output is serialized as CBOR instead.
 	std::string compile(std::string const& _input);
+	/// Performs the same steps as above, but writes the output to @a _output while it is
+	/// produced, so that the complete output never has to be held in memory.
+	/// The output is equivalent to the one returned above, but the errors are written
+	/// after all other members. If an internal error occurs after writing has started,
+	/// the output is ended early and the error is added to the errors.
+	/// CBOR output is not streamed.
+	void compile(std::string const& _input, std::ostream& _output);
+
+	/// Sets the maximum number of threads used for compilation (see CompilerStack::setJobs).
+	/// The output does not depend on this setting.
+	void setJobs(unsigned _jobs) { m_compilerStack.setJobs(_jobs); }
+	/// Limits the time of each query of the SMT checker (see CompilerStack::setSMTTimeout).
+	void setSMTTimeout(unsigned _milliseconds) { m_compilerStack.setSMTTimeout(_milliseconds); }
+	/// Enables incremental solving in the SMT checker (see CompilerStack::setSMTIncremental).
+	void setSMTIncremental(bool _incremental) { m_compilerStack.setSMTIncremental(_incremental); }
+	/// Sets the cache for the results of the queries of the SMT checker
+	/// (see CompilerStack::setSMTQueryCache).
+	void setSMTQueryCache(std::shared_ptr<smt::SMTQueryCache> _cache) { m_compilerStack.setSMTQueryCache(std::move(_cache)); }
 
 private:
-	Json::Value compileInternal(Json::Value const& _input);
+	/// Sets up the compiler stack according to @a _input and compiles.
+	/// Errors and warnings are stored in @a _errors.
+	/// @returns the complete output if the input was invalid, null otherwise.
+	Json::Value compileInternal(Json::Value const& _input, Json::Value& _errors);
+	/// Writes the output for @a _input after compileInternal using @a _writer,
+	/// which is a JsonStreamWriter or a JsonTreeWriter.
+	template <class Writer>
+	void writeOutput(Json::Value const& _input, Json::Value const& _errors, Writer& _writer);
 
 	CompilerStack m_compilerStack;
 	ReadCallback::Callback m_readFile;
@@ -51,6 +51,9 @@
  */
 
 #include <algorithm>
+#include <array>
+#include <memory>
+#include <mutex>
 #include <tuple>
 #include <libsolidity/interface/Exceptions.h>
 #include <libsolidity/parsing/Scanner.h>
@@ -64,31 +67,73 @@ namespace solidity
 
 namespace
 {
+/// Character classes used by the scanner, see c_characterClasses.
+enum CharacterClass: uint8_t
+{
+	DecimalDigit = 1,
+	HexLetter = 2,
+	IdentifierStart = 4,
+	WhiteSpace = 8,
+	LineTerminator = 16,
+	IdentifierPart = IdentifierStart | DecimalDigit,
+	HexDigit = HexLetter | DecimalDigit
+};
+
+/// Table of the classes of all 256 character values, so that classifying
+/// a character is a single lookup.
+class CharacterClasses
+{
+public:
+	CharacterClasses()
+	{
+		m_classes.fill(0);
+		for (char c = '0'; c <= '9'; ++c)
+			m_classes[uint8_t(c)] |= DecimalDigit;
+		for (char c = 'a'; c <= 'f'; ++c)
+			m_classes[uint8_t(c)] |= HexLetter;
+		for (char c = 'A'; c <= 'F'; ++c)
+			m_classes[uint8_t(c)] |= HexLetter;
+		for (char c = 'a'; c <= 'z'; ++c)
+			m_classes[uint8_t(c)] |= IdentifierStart;
+		for (char c = 'A'; c <= 'Z'; ++c)
+			m_classes[uint8_t(c)] |= IdentifierStart;
+		m_classes[uint8_t('_')] |= IdentifierStart;
+		m_classes[uint8_t('$')] |= IdentifierStart;
+		for (char c: {' ', '\n', '\t', '\r'})
+			m_classes[uint8_t(c)] |= WhiteSpace;
+		m_classes[uint8_t('\n')] |= LineTerminator;
+	}
+	bool is(char _c, uint8_t _class) const { return (m_classes[uint8_t(_c)] & _class) != 0; }
+
+private:
+	std::array<uint8_t, 256> m_classes;
+};
+
+CharacterClasses const c_characterClasses;
+
 bool isDecimalDigit(char c)
 {
-	return '0' <= c && c <= '9';
+	return c_characterClasses.is(c, DecimalDigit);
 }
 bool isHexDigit(char c)
 {
-	return isDecimalDigit(c)
-		   || ('a' <= c && c <= 'f')
-		   || ('A' <= c && c <= 'F');
+	return c_characterClasses.is(c, HexDigit);
 }
 bool isLineTerminator(char c)
 {
-	return c == '\n';
+	return c_characterClasses.is(c, LineTerminator);
 }
 bool isWhiteSpace(char c)
 {
-	return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+	return c_characterClasses.is(c, WhiteSpace);
 }
 bool isIdentifierStart(char c)
 {
-	return c == '_' || c == '$' || ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z');
+	return c_characterClasses.is(c, IdentifierStart);
 }
 bool isIdentifierPart(char c)
 {
-	return isIdentifierStart(c) || isDecimalDigit(c);
+	return c_characterClasses.is(c, IdentifierPart);
 }
 int hexValue(char c)
 {
@@ -234,11 +279,25 @@ Token::Value Scanner::selectToken(char _next, Token::Value _then, Token::Value _
 		return _else;
 }
 
+template <class Predicate>
+void Scanner::advanceWhile(Predicate const& _predicate)
+{
+	// m_char can differ from the character at the current position (see
+	// skipMultiLineComment), so it is checked separately.
+	if (!_predicate(m_char))
+		return;
+	string const& source = m_source.source();
+	size_t const start = sourcePos();
+	size_t end = start + 1;
+	while (end < source.size() && _predicate(source[end]))
+		++end;
+	m_char = m_source.advanceAndGet(end - start);
+}
+
 bool Scanner::skipWhitespace()
 {
 	int const startPosition = sourcePos();
-	while (isWhiteSpace(m_char))
-		advance();
+	advanceWhile(isWhiteSpace);
 	// Return whether or not we skipped any characters.
 	return sourcePos() != startPosition;
 }
@@ -246,8 +305,7 @@ bool Scanner::skipWhitespace()
 bool Scanner::skipWhitespaceExceptLF()
 {
 	int const startPosition = sourcePos();
-	while (isWhiteSpace(m_char) && !isLineTerminator(m_char))
-		advance();
+	advanceWhile([](char c) { return isWhiteSpace(c) && !isLineTerminator(c); });
 	// Return whether or not we skipped any characters.
 	return sourcePos() != startPosition;
 }
@@ -258,8 +316,8 @@ Token::Value Scanner::skipSingleLineComment()
 	// to be part of the single-line comment; it is recognized
 	// separately by the lexical grammar and becomes part of the
 	// stream of input elements for the syntactic grammar
-	while (!isLineTerminator(m_char))
-		if (!advance()) break;
+	if (!isLineTerminator(m_char))
+		m_char = m_source.advanceTo("\n");
 
 	return Token::Whitespace;
 }
@@ -297,19 +355,19 @@ Token::Value Scanner::scanSingleLineDocComment()
 Token::Value Scanner::skipMultiLineComment()
 {
 	advance();
-	while (!isSourcePastEndOfInput())
+	if (!isSourcePastEndOfInput())
 	{
-		char ch = m_char;
-		advance();
-
+		m_source.advanceTo("*/");
 		// If we have reached the end of the multi-line comment, we
 		// consume the '/' and insert a whitespace. This way all
 		// multi-line comments are treated as whitespace.
-		if (ch == '*' && m_char == '/')
+		if (!isSourcePastEndOfInput())
 		{
+			m_source.advanceAndGet();
 			m_char = ' ';
 			return Token::Whitespace;
 		}
+		m_char = 0;
 	}
 	// Unterminated multi-line comment.
 	return Token::Illegal;
@@ -438,7 +496,8 @@ void Scanner::scanToken()
 		case '\n':
 		case ' ':
 		case '\t':
-			token = selectToken(Token::Whitespace);
+			skipWhitespace();
+			token = Token::Whitespace;
 			break;
 		case '"':
 		case '\'':
@@ -807,10 +866,10 @@ tuple<Token::Value, unsigned, unsigned> Scanner::scanIdentifierOrKeyword()
 {
 	solAssert(isIdentifierStart(m_char), "");
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
-	addLiteralCharAndAdvance();
-	// Scan the rest of the identifier characters.
-	while (isIdentifierPart(m_char)) //get full literal
-		addLiteralCharAndAdvance();
+	size_t const start = sourcePos();
+	// Scan the full literal and copy it at once.
+	advanceWhile(isIdentifierPart);
+	m_nextToken.literal.assign(m_source.source(), start, sourcePos() - start);
 	literal.complete();
 	return Token::fromIdentifierOrKeyword(m_nextToken.literal);
 }
@@ -822,7 +881,18 @@ char CharStream::advanceAndGet(size_t _chars)
 	m_position += _chars;
 	if (isPastEndOfInput())
 		return 0;
-	return m_source[m_position];
+	return (*m_source)[m_position];
+}
+
+char CharStream::advanceTo(char const* _sequence)
+{
+	if (isPastEndOfInput())
+		return 0;
+	// std::string::find locates candidates with memchr, which scans
+	// the buffer block-wise.
+	size_t position = m_source->find(_sequence, m_position);
+	m_position = (position == string::npos) ? m_source->size() : position;
+	return isPastEndOfInput() ? 0 : (*m_source)[m_position];
 }
 
 char CharStream::rollback(size_t _amount)
@@ -834,34 +904,39 @@ char CharStream::rollback(size_t _amount)
 
 string CharStream::lineAtPosition(int _position) const
 {
+	string const& source = *m_source;
 	// if _position points to \n, it returns the line before the \n
 	using size_type = string::size_type;
-	size_type searchStart = min<size_type>(m_source.size(), _position);
+	size_type searchStart = min<size_type>(source.size(), _position);
 	if (searchStart > 0)
 		searchStart--;
-	size_type lineStart = m_source.rfind('\n', searchStart);
-	if (lineStart == string::npos)
-		lineStart = 0;
-	else
-		lineStart++;
-	return m_source.substr(lineStart, min(m_source.find('\n', lineStart),
-										  m_source.size()) - lineStart);
+	vector<size_t> const& starts = lineStarts();
+	// The line containing searchStart, or the following one if searchStart is a line break.
+	size_type lineStart = *(upper_bound(starts.begin(), starts.end(), searchStart + 1) - 1);
+	return source.substr(lineStart, min(source.find('\n', lineStart), source.size()) - lineStart);
 }
 
 tuple<int, int> CharStream::translatePositionToLineColumn(int _position) const
 {
 	using size_type = string::size_type;
-	size_type searchPosition = min<size_type>(m_source.size(), _position);
-	int lineNumber = count(m_source.begin(), m_source.begin() + searchPosition, '\n');
-	size_type lineStart;
-	if (searchPosition == 0)
-		lineStart = 0;
-	else
+	size_type searchPosition = min<size_type>(m_source->size(), _position);
+	vector<size_t> const& starts = lineStarts();
+	auto line = upper_bound(starts.begin(), starts.end(), searchPosition) - 1;
+	return tuple<int, int>(line - starts.begin(), searchPosition - *line);
+}
+
+vector<size_t> const& CharStream::lineStarts() const
+{
+	// Copies of the stream in other threads might request the index concurrently.
+	call_once(m_lineIndex->computed, [&]()
 	{
-		lineStart = m_source.rfind('\n', searchPosition - 1);
-		lineStart = lineStart == string::npos ? 0 : lineStart + 1;
-	}
-	return tuple<int, int>(lineNumber, searchPosition - lineStart);
+		vector<size_t>& starts = m_lineIndex->lineStarts;
+		string const& source = *m_source;
+		starts.push_back(0);
+		for (size_t i = source.find('\n'); i != string::npos; i = source.find('\n', i + 1))
+			starts.push_back(i + 1);
+	});
+	return m_lineIndex->lineStarts;
 }
 
 
@@ -57,6 +57,8 @@
 #include <libevmasm/SourceLocation.h>
 #include <libsolidity/parsing/Token.h>
 
+#include <mutex>
+
 namespace dev
 {
 namespace solidity
@@ -67,32 +69,57 @@ class AstRawString;
 class AstValueFactory;
 class ParserRecorder;
 
+/**
+ * Character stream over an immutable source buffer. The buffer is shared between copies
+ * of the stream, so handing a stream to a scanner or keeping the source of a scanner around
+ * does not copy the source text.
+ */
 class CharStream
 {
 public:
-	CharStream(): m_position(0) {}
-	explicit CharStream(std::string const& _source): m_source(_source), m_position(0) {}
+	CharStream(): CharStream(std::make_shared<std::string const>()) {}
+	explicit CharStream(std::string const& _source): CharStream(std::make_shared<std::string const>(_source)) {}
+	explicit CharStream(std::string&& _source): CharStream(std::make_shared<std::string const>(std::move(_source))) {}
+	explicit CharStream(std::shared_ptr<std::string const> _source):
+		m_source(std::move(_source)), m_position(0), m_lineIndex(std::make_shared<LineIndex>()) {}
 	int position() const { return m_position; }
-	bool isPastEndOfInput(size_t _charsForward = 0) const { return (m_position + _charsForward) >= m_source.size(); }
-	char get(size_t _charsForward = 0) const { return m_source[m_position + _charsForward]; }
+	bool isPastEndOfInput(size_t _charsForward = 0) const { return (m_position + _charsForward) >= m_source->size(); }
+	char get(size_t _charsForward = 0) const { return (*m_source)[m_position + _charsForward]; }
 	char advanceAndGet(size_t _chars = 1);
+	/// Advances to the next occurrence of @a _sequence at or after the current position,
+	/// or to the end of input if there is none.
+	/// @returns the character at the new position or zero at the end of input.
+	char advanceTo(char const* _sequence);
 	char rollback(size_t _amount);
 
 	void reset() { m_position = 0; }
 
-	std::string const& source() const { return m_source; }
+	std::string const& source() const { return *m_source; }
+	std::shared_ptr<std::string const> const& sharedSource() const { return m_source; }
 
 	///@{
 	///@name Error printing helper functions
-	/// Functions that help pretty-printing parse errors
-	/// Do only use in error cases, they are quite expensive.
+	/// Functions that help pretty-printing parse errors.
+	/// The first call builds an index of line start positions, further calls
+	/// only perform a binary search in it.
 	std::string lineAtPosition(int _position) const;
 	std::tuple<int, int> translatePositionToLineColumn(int _position) const;
 	///@}
 
 private:
-	std::string m_source;
+	struct LineIndex
+	{
+		std::once_flag computed;
+		std::vector<size_t> lineStarts;
+	};
+
+	/// @returns the positions at which the lines of the source start, computed on first use.
+	std::vector<size_t> const& lineStarts() const;
+
+	std::shared_ptr<std::string const> m_source;
 	size_t m_position;
+	/// Copies of the stream share the source and therefore also its line index.
+	std::shared_ptr<LineIndex> m_lineIndex;
 };
 
 
@@ -104,7 +131,8 @@ public:
 
 	explicit Scanner(CharStream const& _source = CharStream(), std::string const& _sourceName = "") { reset(_source, _sourceName); }
 
-	std::string source() const { return m_source.source(); }
+	std::string const& source() const { return m_source.source(); }
+	std::shared_ptr<std::string const> const& sharedSource() const { return m_source.sharedSource(); }
 
 	/// Resets the scanner as if newly constructed with _source and _sourceName as input.
 	void reset(CharStream const& _source, std::string const& _sourceName);
@@ -184,6 +212,10 @@ private:
 
 	bool advance() { m_char = m_source.advanceAndGet(); return !m_source.isPastEndOfInput(); }
 	void rollback(int _amount) { m_char = m_source.rollback(_amount); }
+	/// Advances over the current character and all following characters as long as
+	/// @a _predicate holds, inspecting the source buffer directly.
+	template <class Predicate>
+	void advanceWhile(Predicate const& _predicate);
 
 	inline Token::Value selectToken(Token::Value _tok) { advance(); return _tok; }
 	/// If the next character is _next, advance and return _then, otherwise return _else.
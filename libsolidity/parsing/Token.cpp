@@ -40,7 +40,8 @@
 // You should have received a copy of the GNU General Public License
 // along with solidity.  If not, see <http://www.gnu.org/licenses/>.
 
-#include <map>
+#include <array>
+#include <vector>
 #include <libsolidity/parsing/Token.h>
 #include <boost/range/iterator_range.hpp>
 
@@ -172,17 +173,76 @@ tuple<Token::Value, unsigned int, unsigned int> Token::fromIdentifierOrKeyword(s
 
 	return make_tuple(keywordByName(_literal), 0, 0);
 }
-Token::Value Token::keywordByName(string const& _name)
+namespace
+{
+
+/// Keyword table based on a perfect hash of the keywords in TOKEN_LIST:
+/// every keyword has a slot of its own, so a lookup hashes the name once
+/// and performs at most one string comparison.
+class KeywordTable
 {
-	// The following macros are used inside TOKEN_LIST and cause non-keyword tokens to be ignored
-	// and keywords to be put inside the keywords variable.
+public:
+	KeywordTable()
+	{
+		// The following macros are used inside TOKEN_LIST and cause non-keyword tokens to be ignored
+		// and keywords to be put inside the keywords variable.
 #define KEYWORD(name, string, precedence) {string, Token::name},
 #define TOKEN(name, string, precedence)
-	static const map<string, Token::Value> keywords({TOKEN_LIST(TOKEN, KEYWORD)});
+		m_keywords = {TOKEN_LIST(TOKEN, KEYWORD)};
 #undef KEYWORD
 #undef TOKEN
-	auto it = keywords.find(_name);
-	return it == keywords.end() ? Token::Identifier : it->second;
+		solAssert(m_keywords.size() < 0xff, "");
+		// Search for a seed for which no two keywords share a slot.
+		// With 1024 slots this succeeds after a few dozen attempts.
+		while (!tryAssignSlots())
+			m_seed++;
+	}
+
+	Token::Value lookup(string const& _name) const
+	{
+		uint8_t index = m_slots[slot(_name)];
+		if (index != 0 && m_keywords[index - 1].first == _name)
+			return m_keywords[index - 1].second;
+		return Token::Identifier;
+	}
+
+private:
+	static size_t const c_slots = 1024;
+
+	/// FNV-1a hash of @a _name, combined with the seed.
+	size_t slot(string const& _name) const
+	{
+		uint32_t hash = 2166136261u ^ m_seed;
+		for (char c: _name)
+			hash = (hash ^ uint8_t(c)) * 16777619u;
+		return hash & (c_slots - 1);
+	}
+
+	bool tryAssignSlots()
+	{
+		m_slots.fill(0);
+		for (size_t i = 0; i < m_keywords.size(); ++i)
+		{
+			uint8_t& index = m_slots[slot(m_keywords[i].first)];
+			if (index != 0)
+				return false;
+			index = uint8_t(i + 1);
+		}
+		return true;
+	}
+
+	vector<pair<string, Token::Value>> m_keywords;
+	/// One plus the index of the keyword in m_keywords or zero for unused slots.
+	array<uint8_t, c_slots> m_slots;
+	uint32_t m_seed = 0;
+};
+
+}
+
+Token::Value Token::keywordByName(string const& _name)
+{
+	static KeywordTable const keywords;
+	return keywords.lookup(_name);
 }
 
 #undef KT
@@ -37,10 +37,12 @@
 #include <libsolidity/interface/SourceReferenceFormatter.h>
 #include <libsolidity/interface/GasEstimator.h>
 #include <libsolidity/interface/AssemblyStack.h>
+#include <libsolidity/formal/SMTQueryCache.h>
 
 #include <libevmasm/Instruction.h>
 #include <libevmasm/GasMeter.h>
 
+#include <libdevcore/CBOR.h>
 #include <libdevcore/Common.h>
 #include <libdevcore/CommonData.h>
 #include <libdevcore/CommonIO.h>
@@ -80,6 +82,7 @@ static string const g_strAstJson = "ast-json";
 static string const g_strAstCompactJson = "ast-compact-json";
 static string const g_strBinary = "bin";
 static string const g_strBinaryRuntime = "bin-runtime";
+static string const g_strCbor = "cbor";
 static string const g_strCloneBinary = "clone-bin";
 static string const g_strCombinedJson = "combined-json";
 static string const g_strCompactJSON = "compact-format";
@@ -93,6 +96,7 @@ static string const g_strGas = "gas";
 static string const g_strHelp = "help";
 static string const g_strInputFile = "input-file";
 static string const g_strInterface = "interface";
+static string const g_strJobs = "jobs";
 static string const g_strJulia = "julia";
 static string const g_strLicense = "license";
 static string const g_strLibraries = "libraries";
@@ -108,6 +112,9 @@ static string const g_strOptimizeRuns = "optimize-runs";
 static string const g_strOutputDir = "output-dir";
 static string const g_strOverwrite = "overwrite";
 static string const g_strSignatureHashes = "hashes";
+static string const g_strSMTCache = "smt-cache";
+static string const g_strSMTIncremental = "smt-incremental";
+static string const g_strSMTTimeout = "smt-timeout";
 static string const g_strSources = "sources";
 static string const g_strSourceList = "sourceList";
 static string const g_strSrcMap = "srcmap";
@@ -129,6 +136,7 @@ static string const g_argAstCompactJson = g_strAstCompactJson;
 static string const g_argAstJson = g_strAstJson;
 static string const g_argBinary = g_strBinary;
 static string const g_argBinaryRuntime = g_strBinaryRuntime;
+static string const g_argCbor = g_strCbor;
 static string const g_argCloneBinary = g_strCloneBinary;
 static string const g_argCombinedJson = g_strCombinedJson;
 static string const g_argCompactJSON = g_strCompactJSON;
@@ -136,6 +144,7 @@ static string const g_argFormal = g_strFormal;
 static string const g_argGas = g_strGas;
 static string const g_argHelp = g_strHelp;
 static string const g_argInputFile = g_strInputFile;
+static string const g_argJobs = g_strJobs;
 static string const g_argJulia = g_strJulia;
 static string const g_argLibraries = g_strLibraries;
 static string const g_argLink = g_strLink;
@@ -149,6 +158,9 @@ static string const g_argOptimize = g_strOptimize;
 static string const g_argOptimizeRuns = g_strOptimizeRuns;
 static string const g_argOutputDir = g_strOutputDir;
 static string const g_argSignatureHashes = g_strSignatureHashes;
+static string const g_argSMTCache = g_strSMTCache;
+static string const g_argSMTIncremental = g_strSMTIncremental;
+static string const g_argSMTTimeout = g_strSMTTimeout;
 static string const g_argStandardJSON = g_strStandardJSON;
 static string const g_argStrictAssembly = g_strStrictAssembly;
 static string const g_argVersion = g_strVersion;
@@ -400,6 +412,48 @@ void CommandLineInterface::handleGasEstimation(string const& _contract)
 	}
 }
 
+bool CommandLineInterface::loadSMTQueryCache()
+{
+	if (!m_args.count(g_argSMTCache))
+		return true;
+
+	m_smtQueryCache = make_shared<smt::SMTQueryCache>();
+	string path = m_args[g_argSMTCache].as<string>();
+	if (!boost::filesystem::exists(path))
+		return true;
+
+	Json::Value cache;
+	if (!jsonParseStrict(dev::readFileAsString(path), cache) || !m_smtQueryCache->addFromJson(cache))
+	{
+		cerr << "Invalid SMT query cache: " << path << endl;
+		return false;
+	}
+	return true;
+}
+
+void CommandLineInterface::storeSMTQueryCache()
+{
+	if (!m_smtQueryCache)
+		return;
+
+	string path = m_args[g_argSMTCache].as<string>();
+	Json::Value cache = m_smtQueryCache->toJson();
+	ofstream file(path);
+	file << jsonCompactPrint(cache);
+	if (!file)
+	{
+		cerr << "Could not write SMT query cache: " << path << endl;
+		m_error = true;
+		return;
+	}
+
+	unsigned queries = m_smtQueryCache->hits() + m_smtQueryCache->misses();
+	cerr << "SMT query cache: " << m_smtQueryCache->hits() << " of " << queries << " queries answered from the cache";
+	if (queries > 0)
+		cerr << " (" << (100 * m_smtQueryCache->hits() / queries) << "%)";
+	cerr << ", " << cache.size() << " results stored in " << path << endl;
+}
+
 bool CommandLineInterface::readInputFilesAndConfigureRemappings()
 {
 	bool ignoreMissing = m_args.count(g_argIgnoreMissingFiles);
@@ -570,7 +624,33 @@ Allowed options)",
 			"Set for how many contract runs to optimize."
 			"Lower values will optimize more for initial deployment cost, higher values will optimize more for high-frequency usage."
 		)
+		(
+			(g_argJobs + ",j").c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Use up to n threads to parse and analyse source files, to run the SMT checker "
+			"and to estimate gas costs. The output does not depend on this setting."
+		)
+		(
+			g_argSMTCache.c_str(),
+			po::value<string>()->value_name("file"),
+			"Re-use the results of SMT checker queries stored in the given file and add the new results to it. "
+			"Only the results of the queries of the current run are kept, so the file does not grow with "
+			"results that are no longer needed. Statistics about the cache are printed to stderr."
+		)
+		(
+			g_argSMTTimeout.c_str(),
+			po::value<unsigned>()->value_name("ms")->default_value(0),
+			"Limit the time of each SMT checker query to the given number of milliseconds. "
+			"Queries that reach the limit are reported as unknown. Zero means no limit."
+		)
+		(
+			g_argSMTIncremental.c_str(),
+			"Check the targets of the SMT checker under assumptions instead of adding and removing assertions, "
+			"so that the solver can re-use what it has learned. The warnings do not depend on this setting, "
+			"but counterexamples might."
+		)
 		(g_argPrettyJson.c_str(), "Output JSON in pretty format. Currently it only works with the combined JSON output.")
+		(g_argCbor.c_str(), "Output the combined JSON document encoded as CBOR instead of JSON.")
 		(
 			g_argLibraries.c_str(),
 			po::value<vector<string>>()->value_name("libs"),
@@ -692,6 +772,11 @@ Allowed options)",
 				return false;
 			}
 	}
+	else if (m_args.count(g_argCbor))
+	{
+		cerr << "Option --" << g_argCbor << " requires --" << g_argCombinedJson << "." << endl;
+		return false;
+	}
 	po::notify(m_args);
 
 	return true;
@@ -757,11 +842,20 @@ bool CommandLineInterface::processInput()
 		}
 	}
 
+	if (!loadSMTQueryCache())
+		return false;
+
 	if (m_args.count(g_argStandardJSON))
 	{
 		string input = dev::readStandardInput();
 		StandardCompiler compiler(fileReader);
-		cout << compiler.compile(input) << endl;
+		compiler.setJobs(m_args[g_argJobs].as<unsigned>());
+		compiler.setSMTQueryCache(m_smtQueryCache);
+		compiler.setSMTTimeout(m_args[g_argSMTTimeout].as<unsigned>());
+		compiler.setSMTIncremental(m_args.count(g_argSMTIncremental) > 0);
+		compiler.compile(input, cout);
+		cout << endl;
+		storeSMTQueryCache();
 		return true;
 	}
 
@@ -833,6 +927,10 @@ bool CommandLineInterface::processInput()
 		if (m_args.count(g_argLibraries))
 			m_compiler->setLibraries(m_libraries);
 		m_compiler->setEVMVersion(m_evmVersion);
+		m_compiler->setJobs(m_args[g_argJobs].as<unsigned>());
+		m_compiler->setSMTQueryCache(m_smtQueryCache);
+		m_compiler->setSMTTimeout(m_args[g_argSMTTimeout].as<unsigned>());
+		m_compiler->setSMTIncremental(m_args.count(g_argSMTIncremental) > 0);
 		// TODO: Perhaps we should not compile unless requested
 		bool optimize = m_args.count(g_argOptimize) > 0;
 		unsigned runs = m_args[g_argOptimizeRuns].as<unsigned>();
@@ -845,6 +943,7 @@ bool CommandLineInterface::processInput()
 				*error,
 				(error->type() == Error::Type::Warning) ? "Warning" : "Error"
 			);
+		storeSMTQueryCache();
 
 		if (!successful)
 			return false;
@@ -894,18 +993,56 @@ void CommandLineInterface::handleCombinedJSON()
 	if (!m_args.count(g_argCombinedJson))
 		return;
 
-	Json::Value output(Json::objectValue);
+	if (m_args.count(g_argCbor))
+	{
+		JsonTreeWriter writer;
+		writeCombinedJSON(writer);
+		bytes cbor = cborEncode(writer.result());
+		string data(cbor.begin(), cbor.end());
+		if (m_args.count(g_argOutputDir))
+			createFile("combined.cbor", data);
+		else
+			cout << data;
+		return;
+	}
+
+	if (!m_args.count(g_argPrettyJson) && !m_args.count(g_argOutputDir))
+	{
+		// Compact output to stdout is streamed, one artifact at a time.
+		JsonStreamWriter writer(cout);
+		writeCombinedJSON(writer);
+		cout << endl;
+		return;
+	}
+
+	JsonTreeWriter writer;
+	writeCombinedJSON(writer);
+	string json = m_args.count(g_argPrettyJson) ? dev::jsonPrettyPrint(writer.result()) : dev::jsonCompactPrint(writer.result());
 
-	output[g_strVersion] = ::dev::solidity::VersionString;
+	if (m_args.count(g_argOutputDir))
+		createJson("combined", json);
+	else
+		cout << json << endl;
+}
+
+template <class Writer>
+void CommandLineInterface::writeCombinedJSON(Writer& _writer)
+{
 	set<string> requests;
 	boost::split(requests, m_args[g_argCombinedJson].as<string>(), boost::is_any_of(","));
 	vector<string> contracts = m_compiler->contractNames();
 
+	// Members are written in the order of their names, which is the order Json::Value uses.
+	_writer.beginObject();
+
 	if (!contracts.empty())
-		output[g_strContracts] = Json::Value(Json::objectValue);
+	{
+		_writer.member(g_strContracts);
+		_writer.beginObject();
+	}
 	for (string const& contractName: contracts)
 	{
-		Json::Value& contractData = output[g_strContracts][contractName] = Json::objectValue;
+		Json::Value contractData(Json::objectValue);
 		if (requests.count(g_strAbi))
 			contractData[g_strAbi] = dev::jsonCompactPrint(m_compiler->contractABI(contractName));
 		if (requests.count("metadata"))
@@ -936,36 +1073,44 @@ void CommandLineInterface::handleCombinedJSON()
 			contractData[g_strNatspecDev] = dev::jsonCompactPrint(m_compiler->natspecDev(contractName));
 		if (requests.count(g_strNatspecUser))
 			contractData[g_strNatspecUser] = dev::jsonCompactPrint(m_compiler->natspecUser(contractName));
+		_writer.member(contractName);
+		_writer.value(contractData);
 	}
+	if (!contracts.empty())
+		_writer.endObject();
 
 	bool needsSourceList = requests.count(g_strAst) || requests.count(g_strSrcMap) || requests.count(g_strSrcMapRuntime);
 	if (needsSourceList)
 	{
 		// Indices into this array are used to abbreviate source names in source locations.
-		output[g_strSourceList] = Json::Value(Json::arrayValue);
-
+		Json::Value sourceList(Json::arrayValue);
 		for (auto const& source: m_compiler->sourceNames())
-			output[g_strSourceList].append(source);
+			sourceList.append(source);
+		_writer.member(g_strSourceList);
+		_writer.value(sourceList);
 	}
 
 	if (requests.count(g_strAst))
 	{
 		bool legacyFormat = !requests.count(g_strCompactJSON);
-		output[g_strSources] = Json::Value(Json::objectValue);
+		_writer.member(g_strSources);
+		_writer.beginObject();
 		for (auto const& sourceCode: m_sourceCodes)
 		{
 			ASTJsonConverter converter(legacyFormat, m_compiler->sourceIndices());
-			output[g_strSources][sourceCode.first] = Json::Value(Json::objectValue);
-			output[g_strSources][sourceCode.first]["AST"] = converter.toJson(m_compiler->ast(sourceCode.first));
+			_writer.member(sourceCode.first);
+			_writer.beginObject();
+			_writer.member("AST");
+			converter.write(_writer, m_compiler->ast(sourceCode.first));
+			_writer.endObject();
 		}
+		_writer.endObject();
 	}
 
-	string json = m_args.count(g_argPrettyJson) ? dev::jsonPrettyPrint(output) : dev::jsonCompactPrint(output);
+	_writer.member(g_strVersion);
+	_writer.value(::dev::solidity::VersionString);
 
-	if (m_args.count(g_argOutputDir))
-		createJson("combined", json);
-	else
-		cout << json << endl;
+	_writer.endObject();
 }
 
 void CommandLineInterface::handleAst(string const& _argStr)
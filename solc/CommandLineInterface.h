@@ -60,6 +60,9 @@ private:
 	void outputCompilationResults();
 
 	void handleCombinedJSON();
+	/// Writes the combined JSON output using @a _writer, a JsonStreamWriter or a JsonTreeWriter.
+	template <class Writer>
+	void writeCombinedJSON(Writer& _writer);
 	void handleAst(std::string const& _argStr);
 	void handleBinary(std::string const& _contract);
 	void handleOpcode(std::string const& _contract);
@@ -71,6 +74,12 @@ private:
 	void handleGasEstimation(std::string const& _contract);
 	void handleFormal();
 
+	/// Loads the SMT query cache from the file given by --smt-cache, if it exists.
+	/// @returns false if the file is not a valid cache.
+	bool loadSMTQueryCache();
+	/// Writes the SMT query cache back to its file and prints statistics about it.
+	void storeSMTQueryCache();
+
 	/// Fills @a m_sourceCodes initially and @a m_redirects.
 	bool readInputFilesAndConfigureRemappings();
 	/// Tries to read from the file @a _input or interprets _input literally if that fails.
@@ -105,6 +114,8 @@ private:
 	std::unique_ptr<dev::solidity::CompilerStack> m_compiler;
 	/// EVM version to use
 	EVMVersion m_evmVersion;
+	/// Cache for the results of SMT queries, if enabled
+	std::shared_ptr<smt::SMTQueryCache> m_smtQueryCache;
 };
 
 }
@@ -0,0 +1,87 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Helpers for benchmark test suites. Benchmark suites are only run
+ * if soltest is invoked with --benchmark.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#endif
+
+namespace dev
+{
+namespace test
+{
+
+/// Runs @a _function repeatedly until at least @a _minTime has passed and
+/// returns the average duration of a single run in seconds.
+template <class F>
+double secondsPerRun(F const& _function, std::chrono::milliseconds _minTime = std::chrono::milliseconds(500))
+{
+	using Clock = std::chrono::steady_clock;
+	size_t runs = 0;
+	auto start = Clock::now();
+	std::chrono::duration<double> elapsed(0);
+	do
+	{
+		_function();
+		++runs;
+		elapsed = Clock::now() - start;
+	}
+	while (elapsed < _minTime);
+	return elapsed.count() / runs;
+}
+
+/// Prints the result of a benchmark, i.e. the time per run and, if @a _unit is
+/// not empty, the throughput given that one run processes @a _unitsPerRun units.
+inline void reportBenchmark(
+	std::string const& _name,
+	double _secondsPerRun,
+	std::string const& _unit = std::string(),
+	double _unitsPerRun = 0
+)
+{
+	std::cout << std::left << std::setw(48) << _name << " " << std::right << std::fixed << std::setprecision(3);
+	std::cout << std::setw(12) << _secondsPerRun * 1000 << " ms/run";
+	if (!_unit.empty())
+		std::cout << std::setw(16) << _unitsPerRun / _secondsPerRun << " " << _unit << "/s";
+	std::cout << std::endl;
+}
+
+/// @returns the peak resident set size of the process so far in KiB, or zero if it
+/// cannot be determined on this platform. Since the peak never decreases, benchmarks
+/// comparing memory usage have to run the less demanding variant first.
+inline size_t peakMemoryKiB()
+{
+#if defined(__linux__)
+	rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0)
+		return size_t(usage.ru_maxrss);
+#endif
+	return 0;
+}
+
+}
+} // end namespaces
@@ -62,6 +62,8 @@ Options::Options()
 			disableIPC = true;
 		else if (string(suite.argv[i]) == "--no-smt")
 			disableSMT = true;
+		else if (string(suite.argv[i]) == "--benchmark")
+			benchmark = true;
 
 	if (!disableIPC && ipcPath.empty())
 		if (auto path = getenv("ETH_TEST_IPC"))
@@ -79,7 +79,25 @@ test_suite* init_unit_test_suite( int /*argc*/, char* /*argv*/[] )
 			removeTestSuite(suite);
 	}
 	if (dev::test::Options::get().disableSMT)
+	{
 		removeTestSuite("SMTChecker");
+		if (dev::test::Options::get().benchmark)
+			removeTestSuite("SMTCheckerBenchmark");
+	}
+	if (!dev::test::Options::get().benchmark)
+		for (auto suite: {
+			"ABIFunctionsBenchmark",
+			"ScannerBenchmark",
+			"ImportsBenchmark",
+			"NameAndTypeResolutionBenchmark",
+			"StandardJSONBenchmark",
+			"ASTJSONBenchmark",
+			"SwarmHashBenchmark",
+			"SHA3Benchmark",
+			"OptimiserBenchmark",
+			"SMTCheckerBenchmark"
+		})
+			removeTestSuite(suite);
 
 	return 0;
 }
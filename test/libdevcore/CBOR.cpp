@@ -0,0 +1,149 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for CBOR.h.
+ */
+
+#include <libdevcore/CBOR.h>
+#include <libdevcore/CommonData.h>
+#include <libdevcore/JSON.h>
+
+#include <test/Options.h>
+
+using namespace std;
+
+namespace dev
+{
+namespace test
+{
+
+namespace
+{
+
+Json::Value parse(string const& _json)
+{
+	Json::Value value;
+	BOOST_REQUIRE(jsonParseStrict(_json, value));
+	return value;
+}
+
+string encodeHex(string const& _json)
+{
+	return toHex(cborEncode(parse(_json)));
+}
+
+Json::Value decode(bytes const& _data)
+{
+	return cborDecode(bytesConstRef(&_data));
+}
+
+string decodeHex(string const& _hex)
+{
+	return jsonCompactPrint(decode(fromHex(_hex)));
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(CBOR)
+
+BOOST_AUTO_TEST_CASE(encoding)
+{
+	// Examples from RFC 7049, appendix A.
+	BOOST_CHECK_EQUAL(encodeHex("[0]"), "8100");
+	BOOST_CHECK_EQUAL(encodeHex("[23]"), "8117");
+	BOOST_CHECK_EQUAL(encodeHex("[24]"), "811818");
+	BOOST_CHECK_EQUAL(encodeHex("[1000]"), "811903e8");
+	BOOST_CHECK_EQUAL(encodeHex("[1000000]"), "811a000f4240");
+	BOOST_CHECK_EQUAL(encodeHex("[1000000000000]"), "811b000000e8d4a51000");
+	BOOST_CHECK_EQUAL(encodeHex("[18446744073709551615]"), "811bffffffffffffffff");
+	BOOST_CHECK_EQUAL(encodeHex("[-1, -100, -9223372036854775808]"), "832038633b7fffffffffffffff");
+	BOOST_CHECK_EQUAL(encodeHex("[1.1]"), "81fb3ff199999999999a");
+	BOOST_CHECK_EQUAL(encodeHex("[false, true, null]"), "83f4f5f6");
+	BOOST_CHECK_EQUAL(encodeHex("[\"\\u00fc\"]"), "8162c3bc");
+	BOOST_CHECK_EQUAL(encodeHex("[1, [2, 3], [4, 5]]"), "8301820203820405");
+	BOOST_CHECK_EQUAL(encodeHex("{\"a\": 1, \"b\": [2, 3]}"), "a26161016162820203");
+}
+
+BOOST_AUTO_TEST_CASE(keys_are_sorted)
+{
+	Json::Value value(Json::objectValue);
+	value["b"] = 1;
+	value["a"] = 2;
+	value["ab"] = 3;
+	BOOST_CHECK_EQUAL(toHex(cborEncode(value)), "a361610262616203616201");
+}
+
+BOOST_AUTO_TEST_CASE(round_trip)
+{
+	string json =
+		"{\"\":[],\"array\":[1,-2,3.5,\"x\",null,true,false,{}],"
+		"\"nested\":{\"deep\":{\"deeper\":[[[]]]}},\"string\":\"" + string(300, 'a') + "\"}";
+	BOOST_CHECK_EQUAL(jsonCompactPrint(decode(cborEncode(parse(json)))), json);
+}
+
+BOOST_AUTO_TEST_CASE(decoding)
+{
+	BOOST_CHECK_EQUAL(decodeHex("a26161016162820203"), "{\"a\":1,\"b\":[2,3]}");
+	// Single precision floats and non-shortest arguments are accepted.
+	BOOST_CHECK_EQUAL(decodeHex("82fa3fc00000190001"), "[1.5,1]");
+}
+
+BOOST_AUTO_TEST_CASE(decoding_errors)
+{
+	for (char const* hex: {
+		"",
+		// trailing data
+		"0000",
+		// truncated array, string and argument
+		"8200",
+		"6361",
+		"19ff",
+		// byte string, tag, undefined
+		"4100",
+		"c100",
+		"f7",
+		// indefinite length
+		"9fff",
+		// map with integer key
+		"a10101",
+		// negative integer out of range
+		"3bffffffffffffffff",
+		// array larger than the data
+		"9bffffffffffffffff00"
+	})
+		BOOST_CHECK_THROW(decode(fromHex(hex)), CBORDecodingError);
+}
+
+BOOST_AUTO_TEST_CASE(nesting_depth)
+{
+	// 1000 nested arrays, the innermost one empty.
+	bytes nested(999, 0x81);
+	nested.push_back(0x80);
+	BOOST_CHECK_EQUAL(jsonCompactPrint(decode(nested)), string(1000, '[') + string(1000, ']'));
+	nested.insert(nested.begin(), 0x81);
+	BOOST_CHECK_THROW(decode(nested), CBORDecodingError);
+	// Maps with the key "a", nested far beyond the limit.
+	nested.clear();
+	for (size_t i = 0; i < 100000; ++i)
+		nested += bytes{0xa1, 0x61, 0x61};
+	BOOST_CHECK_THROW(decode(nested), CBORDecodingError);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
@@ -23,6 +23,8 @@
 
 #include <test/Options.h>
 
+#include <sstream>
+
 using namespace std;
 
 namespace dev
@@ -145,6 +147,26 @@ BOOST_AUTO_TEST_CASE(parse_json_strict)
 	BOOST_CHECK(json[0] == "\x80\xec\x80");
 }
 
+BOOST_AUTO_TEST_CASE(json_stream_writer_end_all)
+{
+	ostringstream output;
+	JsonStreamWriter writer(output);
+	BOOST_CHECK(writer.empty());
+	writer.beginObject();
+	writer.member("a");
+	writer.beginArray();
+	writer.value(1);
+	BOOST_CHECK(!writer.empty());
+	BOOST_CHECK_EQUAL(writer.depth(), 2);
+	BOOST_CHECK_EQUAL(writer.lastMember(0), "a");
+	writer.endAll(1);
+	writer.member("b");
+	BOOST_CHECK_EQUAL(writer.lastMember(0), "b");
+	writer.endAll();
+	BOOST_CHECK_EQUAL(writer.depth(), 0);
+	BOOST_CHECK_EQUAL(output.str(), "{\"a\":[1],\"b\":null}");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -0,0 +1,122 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the Keccak-256 routines.
+ */
+
+#include <libdevcore/SHA3.h>
+
+#include <test/Options.h>
+#include <test/Benchmark.h>
+
+using namespace std;
+
+namespace dev
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(SHA3)
+
+BOOST_AUTO_TEST_CASE(known_hashes)
+{
+	BOOST_CHECK_EQUAL(keccak256(string()).hex(), "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470");
+	BOOST_CHECK_EQUAL(keccak256(string("abc")).hex(), "4e03657aea45a94fc7d47ba826c8d667c0d1e6e33a64a036ec44f58fa12d6c45");
+}
+
+BOOST_AUTO_TEST_CASE(incremental)
+{
+	// Lengths around the block size of 136 bytes.
+	for (size_t length: {0, 1, 31, 135, 136, 137, 271, 272, 273, 1000})
+	{
+		bytes data(length);
+		for (size_t i = 0; i < length; ++i)
+			data[i] = byte(i * 7 + length);
+		h256 expectation = keccak256(data);
+
+		Keccak256 hasher;
+		for (size_t pieceSize: {1, 5, 64, 136, 200})
+		{
+			for (size_t i = 0; i < length; i += pieceSize)
+				hasher.update(bytesConstRef(&data).cropped(i, min(pieceSize, length - i)));
+			// The state is reset for the next round.
+			BOOST_CHECK_EQUAL(hasher.finalize(), expectation);
+		}
+		hasher.update(bytesConstRef(&data));
+		hasher.reset();
+		BOOST_CHECK_EQUAL(hasher.finalize(), keccak256(bytes()));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(batch)
+{
+	BOOST_CHECK(keccak256Batch({}).empty());
+	// Inputs shorter and longer than a block.
+	vector<bytes> inputs;
+	for (size_t length = 0; length < 300; length += 7)
+	{
+		inputs.emplace_back(length);
+		for (size_t i = 0; i < length; ++i)
+			inputs.back()[i] = byte(i * 31 + length);
+	}
+	inputs.emplace_back(135, 0xff);
+	inputs.emplace_back(136, 0xff);
+	vector<bytesConstRef> refs;
+	for (bytes const& input: inputs)
+		refs.emplace_back(&input);
+	vector<h256> hashes = keccak256Batch(refs);
+	BOOST_REQUIRE_EQUAL(hashes.size(), inputs.size());
+	for (size_t i = 0; i < inputs.size(); ++i)
+		BOOST_CHECK_EQUAL(hashes[i], keccak256(inputs[i]));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(SHA3Benchmark)
+
+BOOST_AUTO_TEST_CASE(short_inputs)
+{
+	for (size_t length: {32, 64, 96, 128})
+	{
+		vector<bytes> inputs(1000, bytes(length, 0x5a));
+		vector<bytesConstRef> refs;
+		for (bytes const& input: inputs)
+			refs.emplace_back(&input);
+		double single = dev::test::secondsPerRun([&]() {
+			for (bytesConstRef input: refs)
+				keccak256(input);
+		});
+		double incremental = dev::test::secondsPerRun([&]() {
+			Keccak256 hasher;
+			for (bytesConstRef input: refs)
+			{
+				hasher.update(input);
+				hasher.finalize();
+			}
+		});
+		double batch = dev::test::secondsPerRun([&]() { keccak256Batch(refs); });
+		string name = "keccak256 (" + to_string(length) + " bytes";
+		dev::test::reportBenchmark(name + ", one by one)", single, "hashes", refs.size());
+		dev::test::reportBenchmark(name + ", incremental)", incremental, "hashes", refs.size());
+		dev::test::reportBenchmark(name + ", batch)", batch, "hashes", refs.size());
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
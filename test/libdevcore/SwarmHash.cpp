@@ -21,6 +21,9 @@
 #include <libdevcore/SwarmHash.h>
 
 #include <test/Options.h>
+#include <test/Benchmark.h>
+
+#include <thread>
 
 using namespace std;
 
@@ -51,6 +54,41 @@ BOOST_AUTO_TEST_CASE(test_zeros)
 	BOOST_CHECK_EQUAL(swarmHashHex(string(2095104, 0)), string("a9958184589fc11b4027a4c233e777ebe2e99c66f96b74aef2a0638a94dd5439"));
 }
 
+BOOST_AUTO_TEST_CASE(parallel)
+{
+	for (size_t size: {0x1000 + 1, 0x20000, 0x80000, 0x80020, 0x800020})
+	{
+		string input(size, 0);
+		for (size_t i = 0; i < size; ++i)
+			input[i] = char(i * 13 + i / 0x1000);
+		h256 expectation = swarmHash(input);
+		for (unsigned jobs: {1u, 2u, 3u, 200u})
+			BOOST_CHECK_EQUAL(swarmHash(bytesConstRef(input), jobs), expectation);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(SwarmHashBenchmark)
+
+BOOST_AUTO_TEST_CASE(throughput)
+{
+	unsigned const jobs = max(2u, thread::hardware_concurrency());
+	for (size_t size: {0x800, 0x100000, 0x1000000})
+	{
+		string input(size, 'x');
+		double seconds = dev::test::secondsPerRun([&]() { swarmHash(input); });
+		dev::test::reportBenchmark("swarmHash (" + to_string(size) + " bytes)", seconds, "bytes", size);
+		seconds = dev::test::secondsPerRun([&]() { swarmHash(bytesConstRef(input), jobs); });
+		dev::test::reportBenchmark(
+			"swarmHash (" + to_string(size) + " bytes, " + to_string(jobs) + " jobs)",
+			seconds,
+			"bytes",
+			size
+		);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -121,6 +121,26 @@ BOOST_AUTO_TEST_CASE(parameter_collision)
 	BOOST_CHECK_THROW(m.render(), WhiskersError);
 }
 
+BOOST_AUTO_TEST_CASE(unterminated_list)
+{
+	string templ = "a <#b> </c> <d> </ <#> <>";
+	string result = Whiskers(templ)("d", "D").render();
+	BOOST_CHECK_EQUAL(result, "a <#b> </c> D </ <#> <>");
+}
+
+BOOST_AUTO_TEST_CASE(template_reuse)
+{
+	// Parsed templates are shared, values are not.
+	string templ = "<a><#b>[<c>]</b>";
+	vector<map<string, string>> list(2);
+	list[0]["c"] = "0";
+	list[1]["c"] = "1";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "X")("b", list).render(), "X[0][1]");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "Y")("b", vector<map<string, string>>{}).render(), "Y");
+	Whiskers missingValue(templ);
+	BOOST_CHECK_THROW(missingValue("b", list).render(), WhiskersError);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -0,0 +1,179 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the fixed-width 256-bit integer arithmetic, checked against
+ * arbitrary precision integers.
+ */
+
+#include <libdevcore/Word256.h>
+
+#include <test/Options.h>
+
+using namespace std;
+
+namespace dev
+{
+namespace test
+{
+
+namespace
+{
+
+/// @returns deterministic pseudo-random values covering small, large, negative and
+/// power-of-two numbers.
+vector<u256> interestingValues()
+{
+	vector<u256> values{0, 1, 2, 7, 0xff, u256(1) << 64, (u256(1) << 64) - 1, u256(1) << 128, u256(1) << 255, ~u256(0), ~u256(0) - 1};
+	u256 state = 0x243f6a8885a308d3;
+	for (unsigned i = 0; i < 60; ++i)
+	{
+		state = state * u256(0x5851f42d4c957f2d) + 0x14057b7ef767814f;
+		switch (i % 4)
+		{
+		case 0: values.push_back(state >> (i * 7 % 256)); break;
+		case 1: values.push_back(~(state >> (i * 11 % 256))); break;
+		case 2: values.push_back(u256(1) << (i * 13 % 256)); break;
+		default: values.push_back(state); break;
+		}
+	}
+	return values;
+}
+
+bigint const c_modulus = bigint(1) << 256;
+
+u256 wrap(bigint _value)
+{
+	_value %= c_modulus;
+	if (_value < 0)
+		_value += c_modulus;
+	return u256(_value);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(Word256Test)
+
+BOOST_AUTO_TEST_CASE(conversion)
+{
+	for (u256 const& value: interestingValues())
+	{
+		Word256 word(value);
+		BOOST_CHECK_EQUAL(u256(word), value);
+		BOOST_CHECK_EQUAL(word.isZero(), value == 0);
+		BOOST_CHECK_EQUAL(word.fitsUint64(), value <= u256(numeric_limits<uint64_t>::max()));
+		BOOST_CHECK_EQUAL(word.isNegative(), value >= (u256(1) << 255));
+		BOOST_CHECK_EQUAL(word.bitLength(), value == 0 ? 0 : boost::multiprecision::msb(value) + 1);
+		BOOST_CHECK_EQUAL(word.limb(0), uint64_t(value & u256(numeric_limits<uint64_t>::max())));
+	}
+	BOOST_CHECK_EQUAL(u256(Word256(12345)), 12345);
+}
+
+BOOST_AUTO_TEST_CASE(arithmetic)
+{
+	vector<u256> const values = interestingValues();
+	for (u256 const& a: values)
+		for (u256 const& b: values)
+		{
+			Word256 const wa(a);
+			Word256 const wb(b);
+			BOOST_CHECK_EQUAL(u256(wa + wb), u256(a + b));
+			BOOST_CHECK_EQUAL(u256(wa - wb), u256(a - b));
+			BOOST_CHECK_EQUAL(u256(wa * wb), u256(a * b));
+			BOOST_CHECK_EQUAL(u256(wa / wb), b == 0 ? 0 : u256(bigint(a) / bigint(b)));
+			BOOST_CHECK_EQUAL(u256(wa % wb), b == 0 ? 0 : u256(bigint(a) % bigint(b)));
+			BOOST_CHECK_EQUAL(u256(wa & wb), u256(a & b));
+			BOOST_CHECK_EQUAL(u256(wa | wb), u256(a | b));
+			BOOST_CHECK_EQUAL(u256(wa ^ wb), u256(a ^ b));
+			BOOST_CHECK_EQUAL(wa < wb, a < b);
+			BOOST_CHECK_EQUAL(wa == wb, a == b);
+		}
+}
+
+BOOST_AUTO_TEST_CASE(signed_arithmetic)
+{
+	vector<u256> const values = interestingValues();
+	for (u256 const& a: values)
+		for (u256 const& b: values)
+		{
+			bigint const sa = u2s(a);
+			bigint const sb = u2s(b);
+			BOOST_CHECK_EQUAL(signedLessThan(Word256(a), Word256(b)), sa < sb);
+			BOOST_CHECK_EQUAL(u256(signedDiv(Word256(a), Word256(b))), b == 0 ? 0 : wrap(sa / sb));
+			BOOST_CHECK_EQUAL(u256(signedMod(Word256(a), Word256(b))), b == 0 ? 0 : wrap(sa % sb));
+		}
+	u256 const minimum = u256(1) << 255;
+	BOOST_CHECK_EQUAL(u256(signedDiv(Word256(minimum), Word256(~u256(0)))), minimum);
+}
+
+BOOST_AUTO_TEST_CASE(shifts)
+{
+	for (u256 const& value: interestingValues())
+		for (unsigned shift: {0, 1, 8, 63, 64, 65, 127, 128, 200, 255, 256, 300})
+		{
+			BOOST_CHECK_EQUAL(u256(Word256(value) << shift), shift >= 256 ? 0 : u256(value << shift));
+			BOOST_CHECK_EQUAL(u256(Word256(value) >> shift), shift >= 256 ? 0 : u256(value >> shift));
+		}
+}
+
+BOOST_AUTO_TEST_CASE(modular_arithmetic)
+{
+	vector<u256> const values = interestingValues();
+	for (u256 const& a: values)
+		for (u256 const& b: values)
+		{
+			BOOST_CHECK_EQUAL(
+				u256(exp(Word256(a), Word256(b))),
+				u256(boost::multiprecision::powm(bigint(a), bigint(b), c_modulus))
+			);
+			for (u256 const& modulus: {u256(0), u256(7), u256(b ^ a), u256(~u256(0) - 4)})
+			{
+				BOOST_CHECK_EQUAL(
+					u256(addMod(Word256(a), Word256(b), Word256(modulus))),
+					modulus == 0 ? 0 : u256((bigint(a) + bigint(b)) % bigint(modulus))
+				);
+				BOOST_CHECK_EQUAL(
+					u256(mulMod(Word256(a), Word256(b), Word256(modulus))),
+					modulus == 0 ? 0 : u256((bigint(a) * bigint(b)) % bigint(modulus))
+				);
+			}
+		}
+}
+
+BOOST_AUTO_TEST_CASE(bytes_and_sign_extension)
+{
+	for (u256 const& value: interestingValues())
+		for (unsigned index = 0; index < 34; ++index)
+		{
+			u256 expectedByte = index >= 32 ? 0 : u256((value >> (8 * (31 - index))) & 0xff);
+			BOOST_CHECK_EQUAL(u256(byteAt(Word256(index), Word256(value))), expectedByte);
+			u256 expectedExtension = value;
+			if (index < 31)
+			{
+				unsigned testBit = index * 8 + 7;
+				u256 mask = (u256(1) << testBit) - 1;
+				expectedExtension = boost::multiprecision::bit_test(value, testBit) ? u256(value | ~mask) : u256(value & mask);
+			}
+			BOOST_CHECK_EQUAL(u256(signExtend(Word256(index), Word256(value))), expectedExtension);
+		}
+	BOOST_CHECK_EQUAL(u256(signExtend(Word256(~u256(0)), Word256(0x80))), 0x80);
+	BOOST_CHECK_EQUAL(u256(byteAt(Word256(~u256(0)), Word256(0x80))), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
@@ -21,6 +21,7 @@
  */
 
 #include <test/Options.h>
+#include <test/Benchmark.h>
 
 #include <libevmasm/CommonSubexpressionEliminator.h>
 #include <libevmasm/PeepholeOptimiser.h>
@@ -28,6 +29,7 @@
 #include <libevmasm/ControlFlowGraph.h>
 #include <libevmasm/BlockDeduplicator.h>
 #include <libevmasm/Assembly.h>
+#include <libevmasm/ConstantOptimiser.h>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/lexical_cast.hpp>
@@ -112,6 +114,47 @@ namespace
 		AssemblyItems output = CFG(_input);
 		BOOST_CHECK_EQUAL_COLLECTIONS(_expectation.begin(), _expectation.end(), output.begin(), output.end());
 	}
+
+	/// @returns the result of folding @a _instruction applied to the constant @a _arguments,
+	/// the first argument being on top of the stack.
+	u256 fold(Instruction _instruction, vector<u256> const& _arguments)
+	{
+		AssemblyItems input;
+		for (auto it = _arguments.rbegin(); it != _arguments.rend(); ++it)
+			input.push_back(*it);
+		input.push_back(_instruction);
+		AssemblyItems output = CSE(input);
+		BOOST_REQUIRE_EQUAL(output.size(), size_t(1));
+		BOOST_REQUIRE(output.front().type() == Push);
+		return output.front().data();
+	}
+
+	/// Operations whose constant folding is comparatively expensive.
+	vector<Instruction> const c_foldedOperations{
+		Instruction::DIV,
+		Instruction::SDIV,
+		Instruction::MOD,
+		Instruction::SMOD,
+		Instruction::EXP,
+		Instruction::SLT,
+		Instruction::ADDMOD,
+		Instruction::MULMOD,
+		Instruction::SIGNEXTEND,
+		Instruction::SHL
+	};
+
+	/// @returns deterministic pseudo-random constants with a varying number of bits.
+	vector<u256> foldingOperands(size_t _count)
+	{
+		vector<u256> operands;
+		u256 state = 0x243f6a8885a308d3;
+		for (size_t i = 0; i < _count; ++i)
+		{
+			state = state * u256(0x5851f42d4c957f2d) + 0x14057b7ef767814f;
+			operands.push_back(i % 3 == 0 ? u256(i % 40) : state >> unsigned(i % 256));
+		}
+		return operands;
+	}
 }
 
 BOOST_AUTO_TEST_SUITE(Optimiser)
@@ -165,6 +208,34 @@ BOOST_AUTO_TEST_CASE(cse_unneeded_items)
 	checkCSE(input, input);
 }
 
+BOOST_AUTO_TEST_CASE(cse_constant_folding)
+{
+	u256 const minusOne = ~u256(0);
+	u256 const minusTwo = minusOne - 1;
+	u256 const minimum = u256(1) << 255;
+	BOOST_CHECK_EQUAL(fold(Instruction::DIV, {100, 7}), 14);
+	BOOST_CHECK_EQUAL(fold(Instruction::DIV, {100, 0}), 0);
+	BOOST_CHECK_EQUAL(fold(Instruction::DIV, {minusOne, u256(1) << 128}), (u256(1) << 128) - 1);
+	BOOST_CHECK_EQUAL(fold(Instruction::SDIV, {minusOne - 6, 2}), minusTwo - 1);
+	BOOST_CHECK_EQUAL(fold(Instruction::SDIV, {minimum, minusOne}), minimum);
+	BOOST_CHECK_EQUAL(fold(Instruction::MOD, {100, 7}), 2);
+	BOOST_CHECK_EQUAL(fold(Instruction::MOD, {100, 0}), 0);
+	BOOST_CHECK_EQUAL(fold(Instruction::SMOD, {minusOne - 9, 3}), minusOne);
+	BOOST_CHECK_EQUAL(fold(Instruction::SMOD, {10, minusTwo - 1}), 1);
+	BOOST_CHECK_EQUAL(fold(Instruction::EXP, {2, 255}), minimum);
+	BOOST_CHECK_EQUAL(fold(Instruction::EXP, {2, 256}), 0);
+	BOOST_CHECK_EQUAL(fold(Instruction::EXP, {3, 1000}), u256(boost::multiprecision::powm(bigint(3), bigint(1000), bigint(1) << 256)));
+	BOOST_CHECK_EQUAL(fold(Instruction::SLT, {minusOne, 0}), 1);
+	BOOST_CHECK_EQUAL(fold(Instruction::SGT, {minusOne, 0}), 0);
+	BOOST_CHECK_EQUAL(fold(Instruction::SIGNEXTEND, {0, 0x80}), minusOne - 0x7f);
+	BOOST_CHECK_EQUAL(fold(Instruction::SIGNEXTEND, {1, 0x17f}), 0x17f);
+	BOOST_CHECK_EQUAL(fold(Instruction::BYTE, {31, 0x1234}), 0x34);
+	BOOST_CHECK_EQUAL(fold(Instruction::BYTE, {32, 0x1234}), 0);
+	BOOST_CHECK_EQUAL(fold(Instruction::SHL, {255, 3}), minimum);
+	BOOST_CHECK_EQUAL(fold(Instruction::SHL, {256, 3}), 0);
+	BOOST_CHECK_EQUAL(fold(Instruction::SHR, {4, 0x1234}), 0x123);
+}
+
 BOOST_AUTO_TEST_CASE(cse_constant_addition)
 {
 	AssemblyItems input{u256(7), u256(8), Instruction::ADD};
@@ -1144,6 +1215,51 @@ BOOST_AUTO_TEST_CASE(cse_remove_unwanted_masking_of_address)
 
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_AUTO_TEST_SUITE(OptimiserBenchmark)
+
+BOOST_AUTO_TEST_CASE(constant_folding)
+{
+	vector<u256> const operands = foldingOperands(3000);
+	AssemblyItems items;
+	size_t operations = 0;
+	for (size_t i = 0; operations < 1000; ++operations)
+	{
+		Instruction const instruction = c_foldedOperations[operations % c_foldedOperations.size()];
+		for (int j = 0; j < instructionInfo(instruction).args; ++j)
+			items.push_back(operands[i++]);
+		items.push_back(instruction);
+	}
+	double seconds = dev::test::secondsPerRun([&]() {
+		KnownState state;
+		for (AssemblyItem const& item: items)
+			state.feedItem(item);
+	});
+	dev::test::reportBenchmark("constant folding", seconds, "operations", operations);
+}
+
+BOOST_AUTO_TEST_CASE(constant_optimiser)
+{
+	// Constants with long runs of ones or zeros, for which computing them is considered.
+	vector<u256> constants;
+	for (unsigned shift = 16; shift < 256; shift += 3)
+	{
+		constants.push_back((u256(1) << shift) - 1);
+		constants.push_back((u256(1) << shift) + shift);
+		constants.push_back(~u256(0) << shift);
+	}
+	ConstantOptimisationMethod::Params params;
+	params.multiplicity = 1;
+	params.isCreation = false;
+	params.runs = 200;
+	double seconds = dev::test::secondsPerRun([&]() {
+		for (u256 const& value: constants)
+			ComputeMethod(params, value).gasNeeded();
+	});
+	dev::test::reportBenchmark("constant optimiser compute method", seconds, "constants", constants.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 }
 }
 } // end namespaces
@@ -281,6 +281,79 @@ BOOST_AUTO_TEST_CASE(calldata_arrays_too_large)
 	)
 }
 
+BOOST_AUTO_TEST_CASE(calldata_bytes_external_no_copy)
+{
+	string sourceCode = R"(
+		contract C {
+			function f_public(bytes b) public pure returns (uint, byte) {
+				return (b.length, b[b.length - 1]);
+			}
+			function f_external(bytes b) external pure returns (uint, byte) {
+				return (b.length, b[b.length - 1]);
+			}
+		}
+	)";
+	BOTH_ENCODERS(
+		compileAndRun(sourceCode);
+		bytes payload(20000, 'a');
+		payload.back() = 'z';
+		bytes args = encodeArgs(0x20, payload.size()) + payload;
+		ABI_CHECK(callContractFunction("f_public(bytes)", args), encodeArgs(20000, "z"));
+		u256 gasPublic = m_gasUsed;
+		ABI_CHECK(callContractFunction("f_external(bytes)", args), encodeArgs(20000, "z"));
+		u256 gasExternal = m_gasUsed;
+		// The public function copies the payload to memory, the external function
+		// reads it from calldata directly.
+		BOOST_CHECK_LT(gasExternal + 2000, gasPublic);
+	)
+}
+
+BOOST_AUTO_TEST_CASE(calldata_nested_dynamic_arrays)
+{
+	string sourceCode = R"(
+		contract C {
+			function f(bytes[] b, uint i, uint j) external pure returns (uint, uint, byte) {
+				return (b.length, b[i].length, b[i][j]);
+			}
+			function g(uint[][] a, uint i) external pure returns (uint, uint) {
+				uint[] memory m = a[i];
+				uint s = 0;
+				for (uint k = 0; k < a[i].length; k++)
+					s += a[i][k];
+				return (m.length, s);
+			}
+			function h(bytes[] b) external pure returns (bytes32) {
+				bytes[] memory m = b;
+				return keccak256(abi.encodePacked(m[0], m[1]));
+			}
+		}
+	)";
+	NEW_ENCODER(
+		compileAndRun(sourceCode);
+		bytes b = encodeArgs(
+			2, 0x40, 0x80,
+			3, "abc",
+			2, "de"
+		);
+		ABI_CHECK(callContractFunction("f(bytes[],uint256,uint256)", encodeArgs(0x60, 0, 2) + b), encodeArgs(2, 3, "c"));
+		ABI_CHECK(callContractFunction("f(bytes[],uint256,uint256)", encodeArgs(0x60, 1, 0) + b), encodeArgs(2, 2, "d"));
+		// out of bounds accesses
+		ABI_CHECK(callContractFunction("f(bytes[],uint256,uint256)", encodeArgs(0x60, 2, 0) + b), encodeArgs());
+		ABI_CHECK(callContractFunction("f(bytes[],uint256,uint256)", encodeArgs(0x60, 1, 2) + b), encodeArgs());
+		// invalid offset or length of an element
+		ABI_CHECK(callContractFunction("f(bytes[],uint256,uint256)", encodeArgs(0x60, 0, 0, 1, u256(1) << 64)), encodeArgs());
+		ABI_CHECK(callContractFunction("f(bytes[],uint256,uint256)", encodeArgs(0x60, 0, 0, 1, 0x20, 0x1000)), encodeArgs());
+		bytes a = encodeArgs(
+			2, 0x40, 0xa0,
+			2, 1, 2,
+			3, 10, 20, 30
+		);
+		ABI_CHECK(callContractFunction("g(uint256[][],uint256)", encodeArgs(0x40, 0) + a), encodeArgs(2, 3));
+		ABI_CHECK(callContractFunction("g(uint256[][],uint256)", encodeArgs(0x40, 1) + a), encodeArgs(3, 60));
+		ABI_CHECK(callContractFunction("h(bytes[])", encodeArgs(0x20) + b), encodeArgs(dev::keccak256("abcde")));
+	)
+}
+
 BOOST_AUTO_TEST_CASE(decode_from_memory_simple)
 {
 	string sourceCode = R"(
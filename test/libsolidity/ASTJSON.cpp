@@ -21,13 +21,19 @@
  */
 
 #include <test/Options.h>
+#include <test/Benchmark.h>
 
 #include <libsolidity/interface/Exceptions.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/ast/ASTJsonConverter.h>
 
+#include <libdevcore/CBOR.h>
+#include <libdevcore/JSON.h>
+
+#include <boost/algorithm/string/replace.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <sstream>
 #include <string>
 
 using namespace std;
@@ -39,6 +45,57 @@ namespace solidity
 namespace test
 {
 
+namespace
+{
+
+string const c_sourceWithAllNodes = R"(
+	pragma solidity >=0.0;
+	import "a" as A;
+	/// @title C
+	contract C is A.B(1) {
+		using L for uint;
+		struct S { uint a; mapping(uint => bytes32[2]) m; }
+		enum E { X, Y }
+		/// Some comment on Evt.
+		event Evt(uint indexed a, bytes b) anonymous;
+		function(uint) external returns (uint) fp;
+		modifier mod(uint x) { require(x > 0); _; }
+		function f(uint x) public mod(x) returns (uint y, bool) {
+			uint[] memory a = new uint[](2);
+			(, y) = (x, x + 1 finney);
+			for (uint i = 0; i < a.length; i++) { if (i == 1) continue; else break; }
+			do { y += 1; } while (y < 10);
+			emit Evt(y, hex"0102");
+			assembly { y := add(y, 1) }
+			return (x > 1 ? y : uint(x), !true);
+		}
+		function g() public pure { throw; }
+	}
+	library L { function h(uint) internal pure {} }
+)";
+
+/// @returns the AST of c_sourceWithAllNodes followed by @a _copies renamed copies of it,
+/// which is kept alive by @a _compiler.
+SourceUnit const& sourceWithAllNodes(CompilerStack& _compiler, size_t _copies = 0)
+{
+	string source = c_sourceWithAllNodes;
+	for (size_t i = 0; i < _copies; ++i)
+	{
+		string copy = boost::replace_all_copy(c_sourceWithAllNodes, "import \"a\" as A;", "");
+		boost::replace_all(copy, "contract C ", "contract C" + to_string(i) + " ");
+		boost::replace_all(copy, "library L ", "library L" + to_string(i) + " ");
+		boost::replace_all(copy, "using L ", "using L" + to_string(i) + " ");
+		source += copy;
+	}
+	_compiler.addSource("a", "contract B { function B(uint) {} }");
+	_compiler.addSource("b", source);
+	_compiler.setEVMVersion(dev::test::Options::get().evmVersion());
+	BOOST_REQUIRE(_compiler.parseAndAnalyze());
+	return _compiler.ast("b");
+}
+
+}
+
 BOOST_AUTO_TEST_SUITE(SolidityASTJSON)
 
 BOOST_AUTO_TEST_CASE(short_type_name)
@@ -137,6 +194,70 @@ BOOST_AUTO_TEST_CASE(documentation)
 	BOOST_CHECK_EQUAL(documentationC2, "Some comment on fn.");
 }
 
+BOOST_AUTO_TEST_CASE(streamed_ast)
+{
+	CompilerStack c;
+	SourceUnit const& ast = sourceWithAllNodes(c);
+	for (bool legacy: {false, true})
+	{
+		ASTJsonConverter converter(legacy, c.sourceIndices());
+		ostringstream streamed;
+		JsonStreamWriter writer(streamed);
+		converter.write(writer, ast);
+		// The converter can be used again after streaming.
+		BOOST_CHECK_EQUAL(streamed.str(), jsonCompactPrint(converter.toJson(ast)));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(cbor_round_trip)
+{
+	CompilerStack c;
+	Json::Value astJson = ASTJsonConverter(false, c.sourceIndices()).toJson(sourceWithAllNodes(c));
+	bytes cbor = cborEncode(astJson);
+	string json = jsonCompactPrint(astJson);
+	BOOST_CHECK(cbor.size() < json.size());
+	BOOST_CHECK_EQUAL(jsonCompactPrint(cborDecode(&cbor)), json);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(ASTJSONBenchmark)
+
+BOOST_AUTO_TEST_CASE(compact_ast_output)
+{
+	CompilerStack c;
+	sourceWithAllNodes(c, 50);
+
+	size_t outputSize = 0;
+	double treeSeconds = dev::test::secondsPerRun([&]() {
+		outputSize = jsonCompactPrint(ASTJsonConverter(false, c.sourceIndices()).toJson(c.ast("b"))).size();
+	});
+	double streamedSeconds = dev::test::secondsPerRun([&]() {
+		ostringstream output;
+		JsonStreamWriter writer(output);
+		ASTJsonConverter(false, c.sourceIndices()).write(writer, c.ast("b"));
+		outputSize = output.str().size();
+	});
+	dev::test::reportBenchmark("AST JSON (tree and print)", treeSeconds, "bytes", outputSize);
+	dev::test::reportBenchmark("AST JSON (streamed)", streamedSeconds, "bytes", outputSize);
+}
+
+BOOST_AUTO_TEST_CASE(cbor_ast_output)
+{
+	CompilerStack c;
+	Json::Value astJson = ASTJsonConverter(false, c.sourceIndices()).toJson(sourceWithAllNodes(c, 50));
+	string json = jsonCompactPrint(astJson);
+	bytes cbor = cborEncode(astJson);
+
+	double printSeconds = dev::test::secondsPerRun([&]() { json = jsonCompactPrint(astJson); });
+	double encodeSeconds = dev::test::secondsPerRun([&]() { cbor = cborEncode(astJson); });
+	double parseSeconds = dev::test::secondsPerRun([&]() { jsonParseStrict(json, astJson); });
+	double decodeSeconds = dev::test::secondsPerRun([&]() { astJson = cborDecode(&cbor); });
+	dev::test::reportBenchmark("AST JSON (print, " + to_string(json.size()) + " bytes)", printSeconds, "bytes", json.size());
+	dev::test::reportBenchmark("AST CBOR (encode, " + to_string(cbor.size()) + " bytes)", encodeSeconds, "bytes", cbor.size());
+	dev::test::reportBenchmark("AST JSON (parse)", parseSeconds, "bytes", json.size());
+	dev::test::reportBenchmark("AST CBOR (decode)", decodeSeconds, "bytes", cbor.size());
+}
 
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -60,7 +60,7 @@ eth::AssemblyItems compileContract(string const& _sourceCode)
 	BOOST_REQUIRE_NO_THROW(sourceUnit = parser.parse(make_shared<Scanner>(CharStream(_sourceCode))));
 	BOOST_CHECK(!!sourceUnit);
 
-	map<ASTNode const*, shared_ptr<DeclarationContainer>> scopes;
+	unordered_map<ASTNode const*, shared_ptr<DeclarationContainer>> scopes;
 	NameAndTypeResolver resolver({}, scopes, errorReporter);
 	solAssert(Error::containsOnlyWarnings(errorReporter.errors()), "");
 	resolver.registerDeclarations(*sourceUnit);
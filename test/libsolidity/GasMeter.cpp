@@ -91,10 +91,12 @@ public:
 			gas = max(gas, gasForTransaction(hash.asBytes() + arguments, false));
 		}
 
-		gas += GasEstimator(dev::test::Options::get().evmVersion()).functionalEstimation(
-			*m_compiler.runtimeAssemblyItems(m_compiler.lastContractName()),
-			_sig
-		);
+		GasEstimator estimator(dev::test::Options::get().evmVersion());
+		AssemblyItems const& items = *m_compiler.runtimeAssemblyItems(m_compiler.lastContractName());
+		GasMeter::GasConsumption functionGas = estimator.functionalEstimation(items, _sig);
+		// Analysing the function selector only once has to yield the same result.
+		BOOST_CHECK(estimator.functionalEstimations(items, vector<string>{_sig}).at(_sig).tuple() == functionGas.tuple());
+		gas += functionGas;
 		BOOST_REQUIRE(!gas.isInfinite);
 		BOOST_CHECK_EQUAL(gas.value, m_gasUsed);
 	}
@@ -249,6 +251,65 @@ BOOST_AUTO_TEST_CASE(multiple_external_functions)
 	testRunTimeGas("g(uint256)", vector<bytes>{encodeArgs(2)});
 }
 
+BOOST_AUTO_TEST_CASE(repeated_internal_calls)
+{
+	char const* sourceCode = R"(
+		contract test {
+			uint data;
+			function f(uint x) {
+				data = g(x) + g(x + 1);
+			}
+			function g(uint x) internal returns (uint) {
+				return x * 2 + 1;
+			}
+		}
+	)";
+	testCreationTimeGas(sourceCode);
+	testRunTimeGas("f(uint256)", vector<bytes>{encodeArgs(2)});
+}
+
+BOOST_AUTO_TEST_CASE(constant_loop_bound)
+{
+	char const* sourceCode = R"(
+		contract test {
+			uint data;
+			function f(uint x) {
+				for (uint i = 0; i < 10; i++)
+					x = x * 3 + i;
+				data = x + 1;
+			}
+		}
+	)";
+	testCreationTimeGas(sourceCode);
+	testRunTimeGas("f(uint256)", vector<bytes>{encodeArgs(2)});
+}
+
+BOOST_AUTO_TEST_CASE(loop_head_reached_with_different_states)
+{
+	// The path through the if statement is more expensive up to the loop,
+	// but only the cheaper path leaves the loop bound unknown.
+	char const* sourceCode = R"(
+		contract test {
+			uint data;
+			function f(uint x) {
+				uint n = x;
+				if (x > 5) {
+					n = 3;
+					data = 2;
+				}
+				for (uint i = 0; i < n; i++)
+					x = x * 3 + i;
+				data = x;
+			}
+		}
+	)";
+	compile(sourceCode);
+	GasEstimator estimator(dev::test::Options::get().evmVersion());
+	AssemblyItems const& items = *m_compiler.runtimeAssemblyItems(m_compiler.lastContractName());
+	BOOST_CHECK(estimator.functionalEstimation(items, "f(uint256)").isInfinite);
+	BOOST_CHECK(estimator.functionalEstimations(items, vector<string>{"f(uint256)"}).at("f(uint256)").isInfinite);
+}
+
 BOOST_AUTO_TEST_CASE(exponent_size)
 {
 	char const* sourceCode = R"(
@@ -22,10 +22,15 @@
 
 #include <test/libsolidity/ErrorCheck.h>
 #include <test/Options.h>
+#include <test/Benchmark.h>
 
 #include <libsolidity/interface/Exceptions.h>
 #include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/ast/ASTJsonConverter.h>
 
+#include <libdevcore/JSON.h>
+
+#include <boost/algorithm/string/replace.hpp>
 #include <boost/test/unit_test.hpp>
 
 #include <string>
@@ -316,6 +321,183 @@ BOOST_AUTO_TEST_CASE(shadowing_builtins_with_alias)
 	}
 }
 
+namespace
+{
+
+/// @returns the compact AST JSON of all sources and all error messages, which include node IDs.
+string parseAndAnalyze(
+	map<string, string> const& _sources,
+	unsigned _jobs,
+	ReadCallback::Callback const& _reader = ReadCallback::Callback()
+)
+{
+	CompilerStack c(_reader);
+	for (auto const& source: _sources)
+		c.addSource(source.first, source.second);
+	c.setEVMVersion(dev::test::Options::get().evmVersion());
+	c.setJobs(_jobs);
+	string result;
+	if (c.parseAndAnalyze())
+		for (auto const& name: c.sourceNames())
+			result += jsonCompactPrint(ASTJsonConverter(false, c.sourceIndices()).toJson(c.ast(name)));
+	for (auto const& error: c.errors())
+		result += error->typeName() + ": " + *error->comment() + "\n";
+	return result;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(parallel_parsing)
+{
+	map<string, string> files{
+		{"lib/a.sol", "import \"lib/b.sol\"; import {B as X, D} from \"lib/b.sol\"; contract A is X { D d; }"},
+		{"lib/b.sol", "import \"lib/d.sol\"; contract B { function f() public pure returns (uint x) { x = 1; } }"},
+		{"lib/d.sol", "contract D { uint x; function g() public { assembly { sstore(0, 1) } } }"}
+	};
+	ReadCallback::Callback reader = [&](string const& _path)
+	{
+		auto it = files.find(_path);
+		if (it == files.end())
+			return ReadCallback::Result{false, "not found"};
+		return ReadCallback::Result{true, it->second};
+	};
+	map<string, string> sources{
+		{"main.sol", "import \"lib/a.sol\"; contract M is A { function h() public { f(); d.g(); } }"},
+		{"other.sol", "import \"lib/b.sol\"; import \"lib/d.sol\"; contract O is B, D {}"}
+	};
+	string sequential = parseAndAnalyze(sources, 1, reader);
+	BOOST_CHECK(sequential.find("\"id\"") != string::npos);
+	BOOST_CHECK_EQUAL(parseAndAnalyze(sources, 4, reader), sequential);
+
+	map<string, string> invalidSources{
+		{"main.sol", "import \"lib/a.sol\"; import \"lib/missing.sol\"; contract M is A {}"},
+		{"other.sol", "import \"lib/b.sol\"; contract O { uint } }"},
+		{"third.sol", "import \"lib/unknown.sol\";"}
+	};
+	sequential = parseAndAnalyze(invalidSources, 1, reader);
+	BOOST_CHECK(sequential.find("ParserError") != string::npos);
+	BOOST_CHECK(sequential.find("lib/missing.sol") < sequential.find("lib/unknown.sol"));
+	BOOST_CHECK_EQUAL(parseAndAnalyze(invalidSources, 4, reader), sequential);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_analysis)
+{
+	map<string, string> sources{
+		// a.sol and b.sol import each other, b.sol is checked first.
+		{"a.sol", "import \"b.sol\"; contract A { function f() public { new B(); } function g() public { uint unused; } }"},
+		{"b.sol", "import \"a.sol\"; contract B { function h() public; }"},
+		{"c.sol", "import \"a.sol\"; import \"b.sol\"; contract C is A { function f() public { g(); } } contract F is B { uint x = \"a\"; }"},
+		{"d.sol", "contract D { function f() public pure returns (uint) { return 1; } }"},
+		{"e.sol", "import \"d.sol\"; contract G is D { function g() public { assembly { pop(0) } } }"}
+	};
+	string sequential = parseAndAnalyze(sources, 1);
+	BOOST_CHECK(sequential.find("Trying to create an instance of an abstract contract.") != string::npos);
+	BOOST_CHECK(sequential.find("Type literal_string \"a\" is not implicitly convertible") != string::npos);
+	for (unsigned jobs: {2u, 4u, 8u})
+		BOOST_CHECK_EQUAL(parseAndAnalyze(sources, jobs), sequential);
+
+	// Without type errors, the later analysis passes run as well.
+	sources["c.sol"] = "import \"a.sol\"; contract C is A { function f() public { g(); } }";
+	sources["b.sol"] = "import \"a.sol\"; contract B { function h() public { uint unused; } }";
+	sequential = parseAndAnalyze(sources, 1);
+	BOOST_CHECK(sequential.find("Unused local variable.") != string::npos);
+	for (unsigned jobs: {2u, 4u, 8u})
+		BOOST_CHECK_EQUAL(parseAndAnalyze(sources, jobs), sequential);
+}
+
+BOOST_AUTO_TEST_CASE(jobs_kept_by_reset)
+{
+	// Adding a source resets the stack, which must not undo an earlier setJobs.
+	CompilerStack c;
+	c.setJobs(4);
+	c.addSource("a.sol", "contract A {}");
+	BOOST_CHECK_EQUAL(c.jobs(), 4);
+	c.reset();
+	BOOST_CHECK_EQUAL(c.jobs(), 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(ImportsBenchmark)
+
+namespace
+{
+
+/// Generates a project of @a _fileCount files, each of which imports its two predecessors.
+map<string, string> generateProject(size_t _fileCount)
+{
+	map<string, string> files;
+	for (size_t i = 0; i < _fileCount; ++i)
+	{
+		string name = "C" + to_string(i);
+		string source = "pragma solidity >=0.0;\n";
+		for (size_t j = max<size_t>(i, 2) - 2; j < i; ++j)
+			source += "import \"file" + to_string(j) + ".sol\";\n";
+		source += "contract " + name + (i > 0 ? " is C" + to_string(i - 1) : "") + " {\n";
+		for (size_t j = 0; j < 20; ++j)
+			source +=
+				"\tmapping(address => uint) balances" + to_string(i) + "_" + to_string(j) + ";\n"
+				"\tfunction f" + to_string(i) + "_" + to_string(j) + "(uint a, uint b) public returns (uint) {\n"
+				"\t\tif (a > b) balances" + to_string(i) + "_" + to_string(j) + "[msg.sender] += a - b;\n"
+				"\t\treturn balances" + to_string(i) + "_" + to_string(j) + "[msg.sender] * " + to_string(j) + ";\n"
+				"\t}\n";
+		source += "}\n";
+		files["file" + to_string(i) + ".sol"] = move(source);
+	}
+	return files;
+}
+
+size_t projectSize(map<string, string> const& _files)
+{
+	size_t size = 0;
+	for (auto const& file: _files)
+		size += file.second.size();
+	return size;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(parse_project)
+{
+	map<string, string> files = generateProject(500);
+	for (unsigned jobs: {1u, 2u, 4u, 8u})
+	{
+		double seconds = dev::test::secondsPerRun([&]() {
+			CompilerStack c;
+			for (auto const& file: files)
+				c.addSource(file.first, file.second);
+			c.setJobs(jobs);
+			BOOST_REQUIRE(c.parse());
+		});
+		dev::test::reportBenchmark("Parsing 500 files with " + to_string(jobs) + " jobs", seconds, "MB", projectSize(files) / 1e6);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(analyse_project)
+{
+	// Independent inheritance chains of 25 files each, which can be type checked concurrently.
+	map<string, string> files;
+	for (size_t chain = 0; chain < 20; ++chain)
+		for (auto& file: generateProject(25))
+			files["chain" + to_string(chain) + "/" + file.first] = boost::replace_all_copy(
+				file.second,
+				"import \"",
+				"import \"chain" + to_string(chain) + "/"
+			);
+	for (unsigned jobs: {1u, 2u, 4u, 8u})
+	{
+		double seconds = dev::test::secondsPerRun([&]() {
+			CompilerStack c;
+			for (auto const& file: files)
+				c.addSource(file.first, file.second);
+			c.setEVMVersion(dev::test::Options::get().evmVersion());
+			c.setJobs(jobs);
+			BOOST_REQUIRE(c.parseAndAnalyze());
+		});
+		dev::test::reportBenchmark("Analysing 500 files with " + to_string(jobs) + " jobs", seconds, "MB", projectSize(files) / 1e6);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -19,7 +19,20 @@
  */
 
 #include <test/libsolidity/AnalysisFramework.h>
+#include <test/Benchmark.h>
+#include <test/Options.h>
 
+#include <libsolidity/formal/SMTChecker.h>
+#include <libsolidity/formal/SMTLib2Interface.h>
+#include <libsolidity/formal/SMTQueryCache.h>
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/ErrorReporter.h>
+#include <libsolidity/interface/StandardCompiler.h>
+
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/JSON.h>
+
+#include <boost/algorithm/string/predicate.hpp>
 #include <boost/test/unit_test.hpp>
 
 #include <string>
@@ -768,6 +781,323 @@ BOOST_AUTO_TEST_CASE(division_truncates_correctly)
 	CHECK_SUCCESS_NO_WARNINGS(text);
 }
 
+BOOST_AUTO_TEST_CASE(query_cache)
+{
+	string text = R"(
+		contract C {
+			function f(uint a, uint b) public pure returns (uint) {
+				if (a > b)
+					return a - b;
+				assert(a == 0);
+				return b / a;
+			}
+		}
+	)";
+	auto cache = make_shared<smt::SMTQueryCache>();
+	m_compiler.setSMTQueryCache(cache);
+	ErrorList errors = parseAnalyseAndReturnError(text, true, true, true).second;
+	BOOST_CHECK(!errors.empty());
+	BOOST_CHECK_EQUAL(cache->hits(), 0);
+	unsigned queries = cache->misses();
+	BOOST_CHECK(queries > 0);
+	BOOST_CHECK(cache->size() > 0);
+
+	// Analysing the same source again only uses the cache and results in the same warnings.
+	ErrorList cachedErrors = parseAnalyseAndReturnError(text, true, true, true).second;
+	BOOST_CHECK_EQUAL(cache->hits(), queries);
+	BOOST_CHECK_EQUAL(cache->misses(), queries);
+	BOOST_REQUIRE_EQUAL(cachedErrors.size(), errors.size());
+	for (size_t i = 0; i < errors.size(); ++i)
+		BOOST_CHECK_EQUAL(*cachedErrors[i]->comment(), *errors[i]->comment());
+
+	// The same holds for a cache restored from JSON.
+	auto restoredCache = make_shared<smt::SMTQueryCache>();
+	BOOST_REQUIRE(restoredCache->addFromJson(cache->toJson()));
+	BOOST_CHECK_EQUAL(restoredCache->size(), cache->size());
+	m_compiler.setSMTQueryCache(restoredCache);
+	cachedErrors = parseAnalyseAndReturnError(text, true, true, true).second;
+	BOOST_CHECK_EQUAL(restoredCache->hits(), queries);
+	BOOST_CHECK_EQUAL(restoredCache->misses(), 0);
+	BOOST_REQUIRE_EQUAL(cachedErrors.size(), errors.size());
+	for (size_t i = 0; i < errors.size(); ++i)
+		BOOST_CHECK_EQUAL(*cachedErrors[i]->comment(), *errors[i]->comment());
+	BOOST_CHECK_EQUAL(jsonCompactPrint(restoredCache->toJson()), jsonCompactPrint(cache->toJson()));
+	m_compiler.setSMTQueryCache(nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(query_cache_invalid_json)
+{
+	string const hash(64, 'a');
+	for (string const& input: vector<string>{
+		"[]",
+		"{\"" + hash + "\": \"sat\"}",
+		"{\"" + hash + "\": []}",
+		"{\"" + hash + "\": [\"unknown\"]}",
+		"{\"" + hash + "\": [\"unsat\", \"1\"]}",
+		"{\"" + hash + "\": [\"sat\", 1]}",
+		"{\"abc\": [\"unsat\"]}",
+		"{\"" + string(64, 'x') + "\": [\"unsat\"]}"
+	})
+	{
+		Json::Value json;
+		BOOST_REQUIRE(jsonParseStrict(input, json));
+		smt::SMTQueryCache cache;
+		BOOST_CHECK_MESSAGE(!cache.addFromJson(json), input);
+		BOOST_CHECK_EQUAL(cache.size(), 0);
+	}
+	Json::Value json;
+	BOOST_REQUIRE(jsonParseStrict("{\"" + hash + "\": [\"sat\", \"1\"], \"" + string(64, 'b') + "\": [\"unsat\"]}", json));
+	smt::SMTQueryCache cache;
+	BOOST_CHECK(cache.addFromJson(json));
+	BOOST_CHECK_EQUAL(cache.size(), 2);
+	// Results that are not used are not written back.
+	BOOST_CHECK_EQUAL(jsonCompactPrint(cache.toJson()), "{}");
+}
+
+BOOST_AUTO_TEST_CASE(independent_of_jobs)
+{
+	string text = R"(
+		pragma experimental SMTChecker;
+		contract A {
+			uint x;
+			address owner;
+			function f(uint a) public { x = a + 1; }
+			uint y = x + 1;
+			function g(uint a, uint b) public view returns (uint) { assert(a > b); return x / a; }
+		}
+		contract B is A {
+			function h(bool c) public pure returns (uint r) { if (c) r = 1; assert(r == 1); }
+			function k(uint8 a) public pure returns (uint8) { return a * 2; }
+		}
+	)";
+	vector<string> warnings[2];
+	for (unsigned jobs: {1, 4})
+	{
+		CompilerStack compiler;
+		compiler.addSource("", text);
+		compiler.setJobs(jobs);
+		BOOST_REQUIRE(compiler.parseAndAnalyze());
+		for (auto const& error: compiler.errors())
+		{
+			SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(*error);
+			BOOST_REQUIRE(location);
+			warnings[jobs > 1].push_back(to_string(location->start) + ": " + *error->comment());
+		}
+	}
+	BOOST_CHECK(warnings[0].size() >= 6);
+	BOOST_CHECK(warnings[0] == warnings[1]);
+}
+
+BOOST_AUTO_TEST_CASE(timeout_kept_by_reset)
+{
+	// Adding a source resets the stack, which must not undo an earlier setSMTTimeout.
+	CompilerStack compiler;
+	compiler.setSMTTimeout(100);
+	compiler.addSource("", "contract C {}");
+	BOOST_CHECK_EQUAL(compiler.smtTimeout(), 100);
+	compiler.reset();
+	BOOST_CHECK_EQUAL(compiler.smtTimeout(), 100);
+}
+
+BOOST_AUTO_TEST_CASE(expressions_are_shared)
+{
+	smt::Expression a(size_t(1));
+	smt::Expression b(u256(2));
+	smt::Expression sum = a + b;
+	BOOST_CHECK(sum.identical(smt::Expression(size_t(1)) + smt::Expression(size_t(2))));
+	BOOST_CHECK(!sum.identical(b + a));
+	BOOST_CHECK(sum.arguments()[0].identical(a));
+	BOOST_CHECK_EQUAL(sum.name(), "+");
+	BOOST_CHECK(sum.sort() == smt::Sort::Int);
+	BOOST_CHECK((a == b).sort() == smt::Sort::Bool);
+	BOOST_CHECK(!(a == b).identical(a == a));
+	BOOST_CHECK(smt::Expression::ite(a < b, a, b).identical(smt::Expression::ite(a < b, a, b)));
+}
+
+BOOST_AUTO_TEST_CASE(incremental_solving_same_warnings)
+{
+	string text = R"(
+		pragma experimental SMTChecker;
+		contract C {
+			uint x;
+			function f(uint a, uint b) public returns (uint) {
+				if (a > b)
+				{
+					x = a - b;
+					if (x == 0)
+						return 1;
+				}
+				else if (a == b)
+					assert(a - b == 0);
+				else
+					assert(a < b && x > 0);
+				require(b > 2);
+				for (uint i = 0; i < b; ++i)
+					x = x + i;
+				return x / a;
+			}
+		}
+	)";
+	vector<string> warnings[2];
+	for (bool incremental: {false, true})
+	{
+		CompilerStack compiler;
+		compiler.addSource("", text);
+		compiler.setSMTIncremental(incremental);
+		BOOST_REQUIRE(compiler.parseAndAnalyze());
+		for (auto const& error: compiler.errors())
+		{
+			SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(*error);
+			BOOST_REQUIRE(location);
+			// Counterexamples might differ.
+			string const& message = *error->comment();
+			warnings[incremental].push_back(to_string(location->start) + ": " + message.substr(0, message.find(" for:")));
+		}
+	}
+	BOOST_CHECK(warnings[0].size() >= 5);
+	BOOST_CHECK(warnings[0] == warnings[1]);
+}
+
+BOOST_AUTO_TEST_CASE(smtlib2_check_sat_assuming)
+{
+	smt::SMTLib2Interface solver{ReadCallback::Callback()};
+	smt::Expression a = solver.newBool("a");
+	smt::Expression b = solver.newBool("b");
+	solver.addAssertion(smt::Expression::implies(a, b));
+	BOOST_CHECK(boost::ends_with(solver.queryText({}, {}), "(assert (or (not a) b))\n(check-sat)\n"));
+	BOOST_CHECK(boost::ends_with(solver.queryText({a}, {}), "(assert (or (not a) b))\n(check-sat-assuming (a))\n"));
+	BOOST_CHECK(boost::ends_with(solver.queryText({a, b}, {}), "(check-sat-assuming (a b))\n"));
+}
+
+BOOST_AUTO_TEST_CASE(incremental_solving_standard_json)
+{
+	// Queries under assumptions are different from the ones filled into the cache before,
+	// so the mode must reach the checker although adding the sources resets the stack.
+	string input =
+		"{\"language\": \"Solidity\", \"sources\": {\"a.sol\": {\"content\": "
+		"\"pragma experimental SMTChecker; contract C { function f(uint a) public pure { assert(a > 2); } }\"}}}";
+	auto cache = make_shared<smt::SMTQueryCache>();
+	StandardCompiler compiler;
+	compiler.setSMTQueryCache(cache);
+	compiler.compile(input);
+	size_t queries = cache->size();
+	BOOST_REQUIRE(queries > 0);
+	compiler.compile(input);
+	BOOST_CHECK_EQUAL(cache->size(), queries);
+	compiler.setSMTIncremental(true);
+	compiler.compile(input);
+	BOOST_CHECK(cache->size() > queries);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+namespace
+{
+
+/// @returns a contract with a function that consists of an if-else chain with @a _branches branches.
+string branchChain(size_t _branches)
+{
+	string text = "pragma experimental SMTChecker;\ncontract C {\n\tfunction f(uint x, uint y) public pure returns (uint) {\n\t\t";
+	for (size_t i = 0; i < _branches; ++i)
+		text += "if (x == " + to_string(i) + ") y = y + " + to_string(i) + ";\n\t\telse ";
+	text += "y = 1;\n\t\treturn y;\n\t}\n}\n";
+	return text;
+}
+
+/// @returns the contracts contained in the raw string literals of this file.
+vector<string> corpus()
+{
+	string file = readFileAsString((dev::test::Options::get().testPath / "libsolidity" / "SMTChecker.cpp").string());
+	vector<string> sources;
+	for (size_t start = file.find("R\"("); start != string::npos; start = file.find("R\"(", start))
+	{
+		start += 3;
+		size_t end = file.find(")\"", start);
+		BOOST_REQUIRE(end != string::npos);
+		string source = file.substr(start, end - start);
+		if (source.find("contract") != string::npos)
+		{
+			if (source.find("pragma experimental SMTChecker;") == string::npos)
+				source = "pragma experimental SMTChecker;\n" + source;
+			sources.push_back(move(source));
+		}
+		start = end;
+	}
+	return sources;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(SMTCheckerBenchmark)
+
+BOOST_AUTO_TEST_CASE(long_branch_chains)
+{
+	// Builds the path conditions of a chain of 2000 branches the way the checker does,
+	// every path condition is the conjunction of the previous one and the branch condition.
+	size_t initialPeak = dev::test::peakMemoryKiB();
+	size_t const branches = 2000;
+	double expressionSeconds = dev::test::secondsPerRun([&]() {
+		smt::Expression x(u256(7));
+		vector<smt::Expression> pathConditions{smt::Expression(true)};
+		vector<smt::Expression> assertions;
+		for (size_t i = 0; i < branches; ++i)
+		{
+			assertions.push_back(smt::Expression::implies(pathConditions.back() && x == i, x + i > x));
+			pathConditions.push_back(pathConditions.back() && !(x == i));
+		}
+	});
+	size_t expressionPeak = dev::test::peakMemoryKiB();
+	dev::test::reportBenchmark("Path conditions of 2000 branches", expressionSeconds, "branches", branches);
+
+	string text = branchChain(100);
+	double analysisSeconds = dev::test::secondsPerRun([&]() {
+		CompilerStack compiler;
+		compiler.addSource("", text);
+		BOOST_REQUIRE(compiler.parseAndAnalyze());
+	});
+	dev::test::reportBenchmark("SMT checker, function with 100 branches", analysisSeconds, "branches", 100);
+	cout << "Peak memory: " << initialPeak << " KiB initially, " << expressionPeak << " KiB after building the path conditions" << endl;
+}
+
+BOOST_AUTO_TEST_CASE(incremental_solving)
+{
+	vector<shared_ptr<CompilerStack>> compilers;
+	vector<solidity::SMTChecker::Unit> units;
+	for (string const& source: corpus())
+	{
+		auto compiler = make_shared<CompilerStack>();
+		compiler->addSource("", source);
+		if (!compiler->parseAndAnalyze())
+			continue;
+		units += solidity::SMTChecker::units(compiler->ast(""));
+		compilers.push_back(compiler);
+	}
+	BOOST_REQUIRE(!units.empty());
+
+	vector<string> warnings[2];
+	for (bool incremental: {false, true})
+	{
+		double seconds = dev::test::secondsPerRun([&]() {
+			warnings[incremental].clear();
+			for (solidity::SMTChecker::Unit const& unit: units)
+			{
+				ErrorList errors;
+				ErrorReporter errorReporter(errors);
+				solidity::SMTChecker(errorReporter, ReadCallback::Callback(), nullptr, 0, incremental).analyze(unit);
+				for (auto const& error: errors)
+				{
+					// Counterexamples might differ, only the kind of the warning has to be the same.
+					string const& message = *error->comment();
+					warnings[incremental].push_back(message.substr(0, message.find(" for:")));
+				}
+			}
+		});
+		string name = string("SMT checker test corpus (") + (incremental ? "assumptions" : "push and pop") + ")";
+		dev::test::reportBenchmark(name, seconds, "contracts", compilers.size());
+	}
+	BOOST_CHECK(warnings[0] == warnings[1]);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
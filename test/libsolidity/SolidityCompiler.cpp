@@ -21,6 +21,13 @@
 #include <test/libsolidity/AnalysisFramework.h>
 
 #include <test/Options.h>
+#include <test/Benchmark.h>
+
+#include <libsolidity/codegen/ABIFunctions.h>
+#include <libsolidity/codegen/Compiler.h>
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/Types.h>
 
 using namespace std;
 
@@ -53,6 +60,143 @@ BOOST_AUTO_TEST_CASE(does_not_include_creation_time_only_internal_functions)
 	BOOST_CHECK(runtimeBytecode.size() <= 70);
 }
 
+BOOST_AUTO_TEST_CASE(abi_functions_cache)
+{
+	TypePointers types{make_shared<IntegerType>(256), make_shared<ArrayType>(DataLocation::Memory, true)};
+	ABIFunctions uncached;
+	string encoder = uncached.tupleEncoder(types, types);
+	string uncachedFunctions = uncached.requestedFunctions();
+
+	auto cache = make_shared<ABIFunctionsCache>(EVMVersion{});
+	ABIFunctions first(EVMVersion{}, cache);
+	BOOST_CHECK_EQUAL(first.tupleEncoder(types, types), encoder);
+	BOOST_CHECK_EQUAL(first.requestedFunctions(), uncachedFunctions);
+	BOOST_CHECK(cache->functions.count(encoder));
+	size_t cachedFunctions = cache->functions.size();
+
+	// The second instance takes the function and its dependencies from the cache.
+	ABIFunctions second(EVMVersion{}, cache);
+	BOOST_CHECK_EQUAL(second.tupleEncoder(types, types), encoder);
+	BOOST_CHECK_EQUAL(second.requestedFunctions(), uncachedFunctions);
+	BOOST_CHECK_EQUAL(cache->functions.size(), cachedFunctions);
+}
+
+BOOST_AUTO_TEST_CASE(abi_functions_shared_between_contracts)
+{
+	char const* sourceCode = R"(
+		pragma experimental ABIEncoderV2;
+		contract C {
+			struct S { uint a; bytes b; uint[] c; }
+			function f(S s) public pure returns (S) { return s; }
+		}
+		contract D {
+			function f(C.S s) public pure returns (C.S) { return s; }
+		}
+	)";
+	BOOST_REQUIRE(success(sourceCode));
+	m_compiler.setOptimiserSettings(dev::test::Options::get().optimize);
+	BOOST_REQUIRE_MESSAGE(m_compiler.compile(), "Compiling contract failed");
+	// Strip the metadata, it contains the contract name.
+	auto withoutMetadata = [](bytes const& _bytecode) {
+		size_t metadataSize = (size_t(_bytecode[_bytecode.size() - 2]) << 8) + _bytecode.back() + 2;
+		return bytes(_bytecode.begin(), _bytecode.end() - metadataSize);
+	};
+	BOOST_CHECK(
+		withoutMetadata(m_compiler.runtimeObject("C").bytecode) ==
+		withoutMetadata(m_compiler.runtimeObject("D").bytecode)
+	);
+}
+
+BOOST_AUTO_TEST_CASE(release_statement_memory_near_stack_limit)
+{
+	// Saving the free memory pointer for the statement would make a0 unreachable.
+	char const* sourceCode = R"(
+		contract C {
+			function f(uint a0, uint a1, uint a2, uint a3, uint a4, uint a5, uint a6, uint a7, uint a8, uint a9, uint a10, uint a11, uint a12, uint a13)
+				public pure returns (uint r)
+			{
+				r = abi.encode(a13, a0).length;
+			}
+		}
+	)";
+	BOOST_REQUIRE(success(sourceCode));
+	m_compiler.setOptimiserSettings(true);
+	BOOST_REQUIRE_MESSAGE(m_compiler.compile(), "Compiling contract failed");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(ABIFunctionsBenchmark)
+
+BOOST_AUTO_TEST_CASE(encoder_decoder_generation)
+{
+	vector<TypePointers> tuples{
+		{make_shared<IntegerType>(256), make_shared<IntegerType>(160, IntegerType::Modifier::Address)},
+		{make_shared<ArrayType>(DataLocation::Memory), make_shared<ArrayType>(DataLocation::Memory, true)},
+		{make_shared<ArrayType>(DataLocation::Memory, make_shared<IntegerType>(256))},
+		{make_shared<ArrayType>(DataLocation::Memory, make_shared<FixedBytesType>(32), 3), make_shared<IntegerType>(8)},
+		{make_shared<ArrayType>(DataLocation::Memory, make_shared<ArrayType>(DataLocation::Memory, make_shared<IntegerType>(16)))}
+	};
+	size_t functions = 0;
+	size_t codeSize = 0;
+	double seconds = dev::test::secondsPerRun([&]() {
+		ABIFunctions abiFunctions;
+		for (auto const& types: tuples)
+		{
+			abiFunctions.tupleEncoder(types, types);
+			abiFunctions.tupleDecoder(types, true);
+		}
+		string code = abiFunctions.requestedFunctions();
+		codeSize = code.size();
+		functions = 0;
+		for (size_t pos = code.find("function "); pos != string::npos; pos = code.find("function ", pos + 1))
+			functions++;
+	});
+	dev::test::reportBenchmark("ABIFunctions generation (functions)", seconds, "functions", functions);
+	dev::test::reportBenchmark("ABIFunctions generation (code)", seconds, "bytes", codeSize);
+}
+
+BOOST_AUTO_TEST_CASE(shared_struct_encoders)
+{
+	// Contracts that all encode and decode the same structs.
+	size_t const contracts = 20;
+	string source =
+		"pragma experimental ABIEncoderV2;\n"
+		"library L {\n"
+		"\tstruct T { uint8 x; bytes32[] y; }\n"
+		"\tstruct S { uint a; bytes b; uint[] c; T t; T[] ts; }\n"
+		"}\n";
+	for (size_t i = 0; i < contracts; ++i)
+		source +=
+			"contract C" + to_string(i) + " {\n"
+			"\tfunction f(L.S s) public pure returns (L.S) { return s; }\n"
+			"\tfunction g(L.S[] ss, uint n) public pure returns (L.T[] ts, uint) { ts = ss[0].ts; return (ts, n); }\n"
+			"\tfunction h(L.T t) public pure returns (bytes) { return abi.encode(t); }\n"
+			"}\n";
+
+	CompilerStack compilerStack;
+	compilerStack.addSource("", source);
+	compilerStack.setEVMVersion(dev::test::Options::get().evmVersion());
+	BOOST_REQUIRE(compilerStack.parseAndAnalyze());
+	vector<ContractDefinition const*> contractDefinitions;
+	for (ASTPointer<ASTNode> const& node: compilerStack.ast("").nodes())
+		if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
+			contractDefinitions.push_back(contract);
+
+	auto compileAll = [&](bool _shareRoutines) {
+		auto cache = _shareRoutines ? make_shared<ABIFunctionsCache>(dev::test::Options::get().evmVersion()) : nullptr;
+		for (ContractDefinition const* contract: contractDefinitions)
+		{
+			solidity::Compiler compiler(dev::test::Options::get().evmVersion(), false, 200, cache);
+			compiler.compileContract(*contract, {}, bytes());
+		}
+	};
+	double withCache = dev::test::secondsPerRun([&]() { compileAll(true); });
+	double withoutCache = dev::test::secondsPerRun([&]() { compileAll(false); });
+	dev::test::reportBenchmark("ABIEncoderV2 contracts (with ABIFunctionsCache)", withCache, "contracts", contracts);
+	dev::test::reportBenchmark("ABIEncoderV2 contracts (without ABIFunctionsCache)", withoutCache, "contracts", contracts);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
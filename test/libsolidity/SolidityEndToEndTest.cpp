@@ -3760,6 +3760,89 @@ BOOST_AUTO_TEST_CASE(iterated_keccak256_with_bytes)
 	));
 }
 
+BOOST_AUTO_TEST_CASE(keccak256_abi_encode_without_allocation)
+{
+	char const* sourceCode = R"(
+		contract c {
+			function f(uint n) returns (bytes32 h, uint freeMemory)
+			{
+				for (uint i = 0; i < n; i++)
+					h = keccak256(abi.encodePacked(h, i));
+				assembly { freeMemory := mload(0x40) }
+			}
+			function g(uint n, bytes b) returns (bytes32 h, uint freeMemory)
+			{
+				for (uint i = 0; i < n; i++)
+					h = keccak256(abi.encode(h, b, i));
+				assembly { freeMemory := mload(0x40) }
+			}
+		}
+	)";
+	compileAndRun(sourceCode);
+	h256 h;
+	for (unsigned i = 0; i < 3; i++)
+		h = dev::keccak256(h.asBytes() + encodeArgs(u256(i)));
+	ABI_CHECK(callContractFunction("f(uint256)", 3), encodeArgs(h, 0x80));
+	h = h256();
+	for (unsigned i = 0; i < 3; i++)
+		h = dev::keccak256(encodeArgs(h, 0x60, u256(i), 3, string("abc")));
+	ABI_CHECK(callContractFunction("g(uint256,bytes)", 3, 0x40, 3, string("abc")), encodeArgs(h, 0x80));
+
+	// Memory does not grow with the number of iterations.
+	vector<u256> gas;
+	for (unsigned n: {10, 20, 30})
+	{
+		callContractFunction("f(uint256)", u256(n));
+		gas.push_back(m_gasUsed);
+	}
+	BOOST_CHECK_EQUAL(gas[2] - gas[1], gas[1] - gas[0]);
+}
+
+BOOST_AUTO_TEST_CASE(release_statement_memory)
+{
+	char const* sourceCode = R"(
+		contract c {
+			event E(uint i, bytes b);
+			function f(uint n) returns (uint l, uint freeMemory)
+			{
+				for (uint i = 0; i < n; i++)
+				{
+					l += abi.encodePacked(i, msg.sender).length;
+					emit E(i, abi.encode(i));
+				}
+				assembly { freeMemory := mload(0x40) }
+			}
+			function g(uint n) returns (uint l, uint freeMemory)
+			{
+				bytes memory b;
+				for (uint i = 0; i < n; i++)
+				{
+					b = abi.encodePacked(i);
+					l += b.length;
+				}
+				assembly { freeMemory := mload(0x40) }
+			}
+		}
+	)";
+	compileAndRun(sourceCode);
+	ABI_CHECK(callContractFunction("f(uint256)", 3), encodeArgs(3 * 52, m_optimize ? 0x80 : 0x80 + 3 * (0x20 + 52 + 0x40)));
+	BOOST_REQUIRE_EQUAL(m_logs.size(), 3);
+	BOOST_CHECK(m_logs[2].data == encodeArgs(2, 0x40, 0x20, 2));
+	// The result of the assignment is used after the statement.
+	ABI_CHECK(callContractFunction("g(uint256)", 3), encodeArgs(3 * 32, 0x80 + 3 * 0x40));
+
+	if (m_optimize)
+	{
+		vector<u256> gas;
+		for (unsigned n: {10, 20, 30})
+		{
+			callContractFunction("f(uint256)", u256(n));
+			gas.push_back(m_gasUsed);
+		}
+		BOOST_CHECK_EQUAL(gas[2] - gas[1], gas[1] - gas[0]);
+	}
+}
+
 BOOST_AUTO_TEST_CASE(sha3_multiple_arguments)
 {
 	char const* sourceCode = R"(
@@ -117,7 +117,7 @@ bytes compileFirstExpression(
 
 	ErrorList errors;
 	ErrorReporter errorReporter(errors);
-	map<ASTNode const*, shared_ptr<DeclarationContainer>> scopes;
+	unordered_map<ASTNode const*, shared_ptr<DeclarationContainer>> scopes;
 	NameAndTypeResolver resolver(declarations, scopes, errorReporter);
 	resolver.registerDeclarations(*sourceUnit);
 
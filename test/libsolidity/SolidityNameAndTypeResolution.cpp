@@ -23,13 +23,20 @@
 #include <test/libsolidity/AnalysisFramework.h>
 
 #include <test/Options.h>
+#include <test/Benchmark.h>
 
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/analysis/GlobalContext.h>
+#include <libsolidity/analysis/NameAndTypeResolver.h>
+#include <libsolidity/parsing/Parser.h>
+#include <libsolidity/parsing/Scanner.h>
+#include <libsolidity/interface/ErrorReporter.h>
 
 #include <libdevcore/SHA3.h>
 
 #include <boost/test/unit_test.hpp>
 
+#include <chrono>
 #include <string>
 
 using namespace std;
@@ -272,6 +279,48 @@ BOOST_AUTO_TEST_CASE(struct_with_mapping_in_library)
 		}
 }
 
+BOOST_AUTO_TEST_CASE(external_signature_shared_by_function_types)
+{
+	char const* text = R"(
+		library L {
+			function f(uint[] storage x, bytes y) public {}
+		}
+		contract C {
+			event E(uint indexed a, string b);
+			mapping(address => uint[]) public m;
+		}
+	)";
+	SourceUnit const* sourceUnit = parseAndAnalyse(text);
+	auto check = [](vector<FunctionTypePointer> const& _types, string const& _signature)
+	{
+		for (auto const& type: _types)
+		{
+			BOOST_REQUIRE(type);
+			BOOST_CHECK_EQUAL(type->externalSignature(), _signature);
+			BOOST_CHECK(type->externalSignatureHash() == keccak256(_signature));
+			BOOST_CHECK(type->externalIdentifier() == u256(FixedHash<4>::Arith(FixedHash<4>(keccak256(_signature)))));
+		}
+	};
+	for (ASTPointer<ASTNode> const& node: sourceUnit->nodes())
+		if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
+		{
+			if (contract->isLibrary())
+			{
+				FunctionDefinition const& f = *contract->definedFunctions().at(0);
+				check({
+					f.functionType(false),
+					make_shared<FunctionType>(f),
+					FunctionType(f).asMemberFunction(true, true)
+				}, "f(uint256[] storage,bytes)");
+			}
+			else
+			{
+				check({contract->events().at(0)->functionType(true)}, "E(uint256,string)");
+				check({make_shared<FunctionType>(*contract->stateVariables().at(0))}, "m(address,uint256)");
+			}
+		}
+}
+
 BOOST_AUTO_TEST_CASE(state_variable_accessors)
 {
 	char const* text = R"(
@@ -439,6 +488,53 @@ BOOST_AUTO_TEST_CASE(getter_is_memory_type)
 
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_AUTO_TEST_SUITE(NameAndTypeResolutionBenchmark)
+
+BOOST_AUTO_TEST_CASE(deep_inheritance)
+{
+	// A chain of contracts, each inheriting from its predecessor and
+	// referencing the members it inherits.
+	size_t const contracts = 40;
+	size_t const members = 30;
+	string source;
+	for (size_t i = 0; i < contracts; ++i)
+	{
+		string contract = "C" + to_string(i);
+		source += "contract " + contract + (i > 0 ? " is C" + to_string(i - 1) : "") + " {\n";
+		for (size_t j = 0; j < members; ++j)
+		{
+			string member = "_" + to_string(i) + "_" + to_string(j);
+			string inherited = i > 0 ? "v_" + to_string(i - 1) + "_" + to_string(j) : "0";
+			source += "\tuint v" + member + ";\n";
+			source += "\tfunction f" + member + "(uint a) public returns (uint b) { b = a + v" + member + " + " + inherited + "; }\n";
+		}
+		source += "}\n";
+	}
+
+	GlobalContext globalContext;
+	double resolutionSeconds = 0;
+	size_t runs = 0;
+	dev::test::secondsPerRun([&]() {
+		ErrorList errors;
+		ErrorReporter errorReporter(errors);
+		ASTPointer<SourceUnit> sourceUnit = Parser(errorReporter).parse(make_shared<Scanner>(CharStream(source)));
+		BOOST_REQUIRE(sourceUnit);
+
+		auto start = chrono::steady_clock::now();
+		unordered_map<ASTNode const*, shared_ptr<DeclarationContainer>> scopes;
+		NameAndTypeResolver resolver(globalContext.declarations(), scopes, errorReporter);
+		resolver.registerDeclarations(*sourceUnit);
+		for (ASTPointer<ASTNode> const& node: sourceUnit->nodes())
+			resolver.resolveNamesAndTypes(*node);
+		resolutionSeconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		++runs;
+		BOOST_REQUIRE(errors.empty());
+	});
+	dev::test::reportBenchmark("NameAndTypeResolver (deep inheritance)", resolutionSeconds / runs, "contracts", contracts);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 }
 }
 } // end namespaces
@@ -635,6 +635,55 @@ BOOST_AUTO_TEST_CASE(optimise_multi_stores)
 	BOOST_CHECK_EQUAL(numInstructions(m_optimizedBytecode, Instruction::SSTORE), 8);
 }
 
+BOOST_AUTO_TEST_CASE(shared_stack_slots)
+{
+	char const* sourceCode = R"(
+		contract Test {
+			modifier twice { _; _; }
+			uint counter;
+			function f(uint n) public returns (uint r) {
+				{ uint a = n + 7; r += a; }
+				{ uint b; r += b; b = 3; r += b * 10; }
+				for (uint i = 0; i < n; i++) { uint x; x += i; r += x * 100; }
+				{ uint c; uint d = 2; assembly { c := add(d, 1) } r += c * 1000; }
+			}
+			function g() public twice returns (uint r) {
+				{ uint a = 5; r += a; }
+				{ uint b; b += 1; counter += b; }
+				r += counter;
+			}
+		}
+	)";
+	compileBothVersions(sourceCode);
+	compareVersions("f(uint256)", 0);
+	compareVersions("f(uint256)", 4);
+	compareVersions("g()");
+	BOOST_CHECK_LT(m_gasUsedOptimized, m_gasUsedNonOptimized);
+}
+
+BOOST_AUTO_TEST_CASE(shared_stack_slots_avoid_stack_too_deep)
+{
+	char const* sourceCode = R"(
+		contract Test {
+			function f(uint n) public pure returns (uint r) {
+				{
+					uint a0 = n; uint a1 = a0 + 1; uint a2 = a1 + 1; uint a3 = a2 + 1; uint a4 = a3 + 1;
+					uint a5 = a4 + 1; uint a6 = a5 + 1; uint a7 = a6 + 1; uint a8 = a7 + 1; uint a9 = a8 + 1;
+					r += a9;
+				}
+				{
+					uint b0 = n; uint b1 = b0 * 2; uint b2 = b1 * 2; uint b3 = b2 * 2; uint b4 = b3 * 2;
+					uint b5 = b4 * 2; uint b6 = b5 * 2; uint b7 = b6 * 2; uint b8 = b7 * 2; uint b9 = b8 * 2;
+					r += b9;
+				}
+			}
+		}
+	)";
+	// Without sharing slots, the 20 local variables exceed the stack limit.
+	compileAndRunWithOptimizer(sourceCode, 0, "", true);
+	ABI_CHECK(callContractFunction("f(uint256)", 3), encodeArgs(12 + 3 * 512));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -21,6 +21,7 @@
  */
 
 #include <libsolidity/parsing/Scanner.h>
+#include <test/Benchmark.h>
 #include <boost/test/unit_test.hpp>
 
 namespace dev
@@ -413,6 +414,80 @@ BOOST_AUTO_TEST_CASE(invalid_hex_literal_nonhex_string)
 	BOOST_CHECK_EQUAL(scanner.next(), Token::Illegal);
 }
 
+BOOST_AUTO_TEST_CASE(shared_source)
+{
+	auto source = std::make_shared<std::string const>("contract C {}");
+	Scanner scanner(CharStream(source), "a");
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Contract);
+	BOOST_CHECK_EQUAL(&scanner.source(), source.get());
+	// Copies of the stream and resetting the scanner do not copy the source.
+	Scanner other;
+	other.reset(CharStream(scanner.sharedSource()), "b");
+	BOOST_CHECK_EQUAL(&other.source(), source.get());
+	BOOST_CHECK_EQUAL(other.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(other.currentLiteral(), "C");
+	BOOST_CHECK_EQUAL(source.use_count(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(line_column_translation)
+{
+	CharStream stream("ab\n\ncd\nef");
+	auto lineColumn = [&](int _position) { return stream.translatePositionToLineColumn(_position); };
+	BOOST_CHECK(lineColumn(0) == std::make_tuple(0, 0));
+	BOOST_CHECK(lineColumn(2) == std::make_tuple(0, 2));
+	BOOST_CHECK(lineColumn(3) == std::make_tuple(1, 0));
+	BOOST_CHECK(lineColumn(4) == std::make_tuple(2, 0));
+	BOOST_CHECK(lineColumn(6) == std::make_tuple(2, 2));
+	BOOST_CHECK(lineColumn(8) == std::make_tuple(3, 1));
+	BOOST_CHECK(lineColumn(100) == std::make_tuple(3, 2));
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(0), "ab");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(2), "ab");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(3), "");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(5), "cd");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(100), "ef");
+	BOOST_CHECK_EQUAL(CharStream("\nx").lineAtPosition(0), "x");
+	BOOST_CHECK_EQUAL(CharStream("").lineAtPosition(0), "");
+	BOOST_CHECK(CharStream("").translatePositionToLineColumn(0) == std::make_tuple(0, 0));
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(ScannerBenchmark)
+
+BOOST_AUTO_TEST_CASE(line_column_translation)
+{
+	std::string source;
+	for (size_t i = 0; i < 50000; ++i)
+		source += "\t\tuint x" + std::to_string(i) + " = " + std::to_string(i) + ";\n";
+	CharStream stream(source);
+	double seconds = dev::test::secondsPerRun([&]() {
+		for (size_t position = 0; position < source.size(); position += 97)
+			stream.translatePositionToLineColumn(position);
+	});
+	dev::test::reportBenchmark("Position to line and column", seconds, "positions", source.size() / 97.0);
+}
+
+BOOST_AUTO_TEST_CASE(scanning_throughput)
+{
+	std::string source;
+	for (size_t i = 0; i < 5000; ++i)
+		source +=
+			"\t/* Returns the balance of account number " + std::to_string(i) + ",\n"
+			"\t   multiplied by the current factor. */\n"
+			"\tfunction balance" + std::to_string(i) + "(address owner) public view returns (uint256) {\n"
+			"\t\t// Factors are always positive.\n"
+			"\t\treturn balances[owner] * factor + " + std::to_string(i) + ";\n"
+			"\t}\n\n";
+	size_t tokens = 0;
+	double seconds = dev::test::secondsPerRun([&]() {
+		Scanner scanner(CharStream(source), "");
+		for (tokens = 0; scanner.currentToken() != Token::EOS; ++tokens)
+			scanner.next();
+	});
+	dev::test::reportBenchmark("Scanner throughput (bytes)", seconds, "MB", source.size() / 1e6);
+	dev::test::reportBenchmark("Scanner throughput (tokens)", seconds, "tokens", tokens);
+}
 
 BOOST_AUTO_TEST_SUITE_END()
 
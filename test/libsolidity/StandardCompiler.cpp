@@ -20,11 +20,15 @@
  */
 
 #include <string>
+#include <sstream>
+#include <thread>
 #include <boost/test/unit_test.hpp>
 #include <libsolidity/interface/StandardCompiler.h>
+#include <libdevcore/CBOR.h>
 #include <libdevcore/JSON.h>
 
 #include "../Metadata.h"
+#include "../Benchmark.h"
 
 using namespace std;
 using namespace dev::eth;
@@ -93,6 +97,72 @@ Json::Value compile(string const& _input)
 	return ret;
 }
 
+string compileStreamed(string const& _input)
+{
+	StandardCompiler compiler;
+	ostringstream output;
+	compiler.compile(_input, output);
+	return output.str();
+}
+
+/// @returns a standard JSON input with @a _files files of @a _contracts contracts each,
+/// selecting all outputs.
+string largeInput(size_t _files, size_t _contracts)
+{
+	Json::Value input;
+	input["language"] = "Solidity";
+	for (size_t i = 0; i < _files; ++i)
+	{
+		string source;
+		for (size_t j = 0; j < _contracts; ++j)
+		{
+			string name = "C" + to_string(i) + "_" + to_string(j);
+			source +=
+				"/// @title " + name + "\n"
+				"contract " + name + " {\n"
+				"\tuint[] values;\n"
+				"\tevent Added(uint indexed value);\n"
+				"\t/// @dev Adds @param _value.\n"
+				"\tfunction add(uint _value) public { values.push(_value); emit Added(_value); }\n"
+				"\tfunction sum() public view returns (uint s) { for (uint k = 0; k < values.length; k++) s += values[k]; }\n"
+				"}\n";
+		}
+		input["sources"]["file" + to_string(i) + ".sol"]["content"] = source;
+	}
+	input["settings"]["outputSelection"]["*"]["*"].append("*");
+	input["settings"]["outputSelection"]["*"][""].append("*");
+	return jsonCompactPrint(input);
+}
+
+/// @returns a standard JSON input with a contract of @a _functions external functions,
+/// each calling an internal function, selecting only the gas estimates.
+string gasEstimatesInput(size_t _functions)
+{
+	string source = "contract C {\n\tuint[] values;\n";
+	for (size_t i = 0; i < _functions; ++i)
+	{
+		string index = to_string(i);
+		source +=
+			"\tfunction f" + index + "(uint a, uint b) public returns (uint) { return g" + index + "(a) + b; }\n"
+			"\tfunction g" + index + "(uint a) internal returns (uint) { values.push(a * " + index + "); return values.length; }\n";
+	}
+	source += "}\n";
+	Json::Value input;
+	input["language"] = "Solidity";
+	input["sources"]["C.sol"]["content"] = source;
+	input["settings"]["optimizer"]["enabled"] = true;
+	input["settings"]["outputSelection"]["*"]["*"].append("evm.gasEstimates");
+	return jsonCompactPrint(input);
+}
+
+/// @returns the output of the compilation of @a _input using @a _jobs threads.
+string compileWithJobs(string const& _input, unsigned _jobs)
+{
+	StandardCompiler compiler;
+	compiler.setJobs(_jobs);
+	return compiler.compile(_input);
+}
+
 } // end anonymous namespace
 
 BOOST_AUTO_TEST_SUITE(StandardCompiler)
@@ -768,6 +838,128 @@ BOOST_AUTO_TEST_CASE(evm_version)
 }
 
 
+BOOST_AUTO_TEST_CASE(streamed_output)
+{
+	vector<string> inputs{
+		"invalid",
+		"{}",
+		R"({"language": "Solidity", "sources": {"a": {"content": "contract A { function f() { g(); } }"}}})",
+		largeInput(2, 2),
+		// Contract names do not sort by file here: "A.sol:C" < "A:B", but "A" < "A.sol".
+		R"({
+			"language": "Solidity",
+			"sources": {
+				"A": { "content": "contract B { function f() public pure {} }" },
+				"A.sol": { "content": "import \"A\"; contract C is B { }" }
+			},
+			"settings": { "outputSelection": { "*": { "*": [ "abi", "evm.bytecode.object" ], "": [ "legacyAST" ] } } }
+		})"
+	};
+	for (string const& input: inputs)
+	{
+		// The streamed output writes the errors last, so only the parsed outputs are equal.
+		solidity::StandardCompiler compiler;
+		Json::Value streamed;
+		Json::Value output;
+		BOOST_REQUIRE(jsonParseStrict(compileStreamed(input), streamed));
+		BOOST_REQUIRE(jsonParseStrict(compiler.compile(input), output));
+		BOOST_CHECK_EQUAL(jsonCompactPrint(streamed), jsonCompactPrint(output));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(streamed_output_internal_error)
+{
+	// The content of the source is not a string, but its URL can be read. Writing the
+	// assembly needs the contents of all sources and fails after writing has started.
+	string input = R"({
+		"language": "Solidity",
+		"sources": {"a.sol": {"content": [], "urls": ["a.sol"]}},
+		"settings": {"outputSelection": {"*": {"*": ["abi", "evm.assembly"]}}}
+	})";
+	solidity::StandardCompiler compiler([](string const&) {
+		return ReadCallback::Result{true, "contract A { function f() public {} }"};
+	});
+	ostringstream stream;
+	compiler.compile(input, stream);
+	BOOST_CHECK(stream.str().find("\"abi\"") != string::npos);
+	Json::Value output;
+	BOOST_REQUIRE(jsonParseStrict(stream.str(), output));
+	BOOST_REQUIRE(output["errors"].isArray());
+	BOOST_CHECK_EQUAL(output["errors"][output["errors"].size() - 1]["type"].asString(), "InternalCompilerError");
+	BOOST_CHECK(!output.isMember("sources"));
+}
+
+BOOST_AUTO_TEST_CASE(cbor_output)
+{
+	Json::Value input;
+	BOOST_REQUIRE(jsonParseStrict(largeInput(2, 2), input));
+	string json = compileStreamed(jsonCompactPrint(input));
+
+	input["settings"]["outputFormat"] = "cbor";
+	string cbor = compileStreamed(jsonCompactPrint(input));
+	BOOST_CHECK(cbor.size() < json.size());
+	Json::Value parsedJson;
+	BOOST_REQUIRE(jsonParseStrict(json, parsedJson));
+	BOOST_CHECK_EQUAL(jsonCompactPrint(cborDecode(&cbor)), jsonCompactPrint(parsedJson));
+	solidity::StandardCompiler compiler;
+	BOOST_CHECK(compiler.compile(jsonCompactPrint(input)) == cbor);
+
+	input["settings"]["outputFormat"] = "xml";
+	Json::Value result = compile(jsonCompactPrint(input));
+	BOOST_CHECK(containsError(result, "JSONError", "Invalid output format requested."));
+}
+
+BOOST_AUTO_TEST_CASE(gas_estimates_independent_of_jobs)
+{
+	for (string const& input: {gasEstimatesInput(12), largeInput(2, 2)})
+	{
+		string output = compileWithJobs(input, 1);
+		BOOST_CHECK(output.find("\"gasEstimates\"") != string::npos);
+		BOOST_CHECK_EQUAL(compileWithJobs(input, 4), output);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(StandardJSONBenchmark)
+
+BOOST_AUTO_TEST_CASE(output_memory)
+{
+	// Run this suite on its own: peak memory usage can only be compared as long as
+	// no earlier test has exceeded the peak of the streamed output.
+	string input = largeInput(10, 10);
+	size_t initialPeak = dev::test::peakMemoryKiB();
+
+	size_t outputSize = 0;
+	double streamedSeconds = dev::test::secondsPerRun([&]() {
+		outputSize = compileStreamed(input).size();
+	});
+	size_t streamedPeak = dev::test::peakMemoryKiB();
+
+	double treeSeconds = dev::test::secondsPerRun([&]() {
+		solidity::StandardCompiler compiler;
+		outputSize = compiler.compile(input).size();
+	});
+	size_t treePeak = dev::test::peakMemoryKiB();
+
+	dev::test::reportBenchmark("Standard JSON output (streamed)", streamedSeconds, "bytes", outputSize);
+	dev::test::reportBenchmark("Standard JSON output (tree)", treeSeconds, "bytes", outputSize);
+	cout << "Output size: " << outputSize / 1024 << " KiB, peak memory: " <<
+		initialPeak << " KiB initially, " <<
+		streamedPeak << " KiB after streaming, " <<
+		treePeak << " KiB after building the tree" << endl;
+}
+
+BOOST_AUTO_TEST_CASE(gas_estimates)
+{
+	string input = gasEstimatesInput(100);
+	unsigned jobs = max(thread::hardware_concurrency(), 2u);
+	double sequentialSeconds = dev::test::secondsPerRun([&]() { compileWithJobs(input, 1); });
+	double parallelSeconds = dev::test::secondsPerRun([&]() { compileWithJobs(input, jobs); });
+	dev::test::reportBenchmark("evm.gasEstimates (1 job)", sequentialSeconds, "functions", 200);
+	dev::test::reportBenchmark("evm.gasEstimates (" + to_string(jobs) + " jobs)", parallelSeconds, "functions", 200);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }